@@ -2,23 +2,60 @@
 #include "utTest/FactorialUnitTest.h"
 #include "utTest/FibonacciUnitTest.h"
 #include "utTest/TimingUnitTest.h"
+#include "utTest/AllocationUnitTest.h"
+#include "utTest/ParameterizedUnitTest.h"
+#include "utTest/PropertyUnitTest.h"
+#include "utTest/FixtureUnitTest.h"
+#include "utTest/ExceptionCheckBenchmark.h"
 
 #include <iostream>
-#include <fstream>
 
-int main() {
+int main(int argc, char** argv) {
 
     UT_Factorial FactorialTest;
     UT_Fibonacci FibonacciTest;
-    UT_Timing TimingTest;
+    Test::Parameterized<UT_FibonacciTable> FibonacciTable("Fibonacci Table", { {0, 0}, {1, 1}, {2, 1}, {10, 55}, {20, 6765} });
+    Test::Parameterized<UT_FibonacciSequence> FibonacciSequence("Fibonacci Sequence", 24,
+        [](size_t index) { return static_cast<int64_t>(index) + 2; }, 8);
+    UT_FactorialProperty FactorialProperty;
+    UT_FibonacciProperty FibonacciProperty;
+    FibonacciNumbers Numbers("Fibonacci Numbers", computeFibonacciNumbers);
+    UT_FibonacciGrowth FibonacciGrowth(Numbers);
+    UT_FibonacciParity FibonacciParity(Numbers);
+    BM_ExceptionCheckFunction ExceptionCheckFunctionBenchmark;
+    BM_ExceptionCheckTemplate ExceptionCheckTemplateBenchmark;
 
-    Test::TestCollection::runTests();
+    if (!Test::TestCollection::parseArguments(argc, argv))
+        return EXIT_FAILURE;
+
+    //the shards are balanced by the history, a listed shard has to match the one that runs
+    Test::TestCollection::loadHistory("./UT_history.txt");
+
+    if (Test::TestCollection::isListing()) {
+        Test::TestCollection::listTests(std::cout);
+        return EXIT_SUCCESS;
+    }
 
-    Test::TestCollection::report(std::cout, true);
+    Test::TestCollection::setPerfCounters(true);
+    Test::TestCollection::setAllocationTracking(true);
+    bool hasBaseline = Test::TestCollection::loadBaseline("./UT_baseline.txt");
+
+    Test::TextReporter console(std::cout, true);
+    Test::TextReporter file("./UT_report.txt");
+    Test::JUnitReporter junit("./UT_report.xml");
+    Test::JsonReporter json("./UT_report.jsonl");
+    Test::TestCollection::addReporter(&console);
+    Test::TestCollection::addReporter(&file);
+    Test::TestCollection::addReporter(&junit);
+    Test::TestCollection::addReporter(&json);
+
+    Test::TestCollection::runTests();
 
-    std::ofstream stream("./UT_report.txt");
-    Test::TestCollection::report(stream);
-    stream.close();
+    Test::TestCollection::saveTimings("./UT_timings.txt");
+    Test::TestCollection::saveCounters("./UT_counters.txt");
+    Test::TestCollection::saveHistory("./UT_history.txt");
+    Test::TestCollection::saveStatistics("./UT_statistics.txt");
+    if (!hasBaseline) Test::TestCollection::saveTimings("./UT_baseline.txt");
 
     return EXIT_SUCCESS;
 }
\ No newline at end of file
@@ -0,0 +1,138 @@
+#include "AllocationTracker.h"
+
+#if defined(UT_TRACK_ALLOCATIONS)
+#include <cstdlib>
+#include <new>
+
+#if defined(_WIN32) || defined(__linux__)
+#include <malloc.h>
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#endif
+#endif
+
+namespace Test {
+	thread_local AllocationTracker::Statistics AllocationTracker::tStatistics;
+
+	/// <summary>
+	/// Records an Allocation on the calling Thread
+	/// </summary>
+	/// <param name="size">the usable Size of the Block</param>
+	void AllocationTracker::recordAllocation(size_t size) noexcept {
+		Statistics& statistics = tStatistics;
+		statistics.mAllocations++;
+		statistics.mBytes += size;
+		statistics.mLive += static_cast<int64_t>(size);
+		if (statistics.mLive > statistics.mPeak) statistics.mPeak = statistics.mLive;
+	}
+
+	/// <summary>
+	/// Records a Deallocation on the calling Thread
+	/// </summary>
+	/// <param name="size">the usable Size of the Block</param>
+	void AllocationTracker::recordDeallocation(size_t size) noexcept {
+		Statistics& statistics = tStatistics;
+		statistics.mDeallocations++;
+		statistics.mLive -= static_cast<int64_t>(size);
+	}
+
+	/// <summary>
+	/// returns the Number of Allocations made by the calling Thread so far
+	/// </summary>
+	/// <returns>the Number of Allocations</returns>
+	uint64_t AllocationTracker::allocationCount() noexcept {
+		return tStatistics.mAllocations;
+	}
+
+	/// <summary>
+	/// Starts a Measurement on the calling Thread
+	/// </summary>
+	/// <returns>the Counters at the Start, to be passed to end</returns>
+	AllocationTracker::Statistics AllocationTracker::begin() noexcept {
+		//the peak is measured from here on
+		tStatistics.mPeak = tStatistics.mLive;
+		return tStatistics;
+	}
+
+	/// <summary>
+	/// Ends a Measurement on the calling Thread
+	/// </summary>
+	/// <param name="start">the Counters returned by begin</param>
+	/// <returns>the Allocations since begin, Peak is the highest Number of live Bytes above the Start</returns>
+	AllocationTracker::Statistics AllocationTracker::end(const Statistics& start) noexcept {
+		Statistics result;
+		result.mAllocations = tStatistics.mAllocations - start.mAllocations;
+		result.mDeallocations = tStatistics.mDeallocations - start.mDeallocations;
+		result.mBytes = tStatistics.mBytes - start.mBytes;
+		result.mLive = tStatistics.mLive - start.mLive;
+		result.mPeak = tStatistics.mPeak - start.mLive;
+		return result;
+	}
+}
+
+#if defined(UT_TRACK_ALLOCATIONS)
+namespace {
+	/// <summary>
+	/// returns the Size the Allocator actually reserved for a Block
+	/// </summary>
+	size_t usableSize(void* pointer) noexcept {
+#if defined(_WIN32)
+		return _msize(pointer);
+#elif defined(__linux__)
+		return malloc_usable_size(pointer);
+#elif defined(__APPLE__)
+		return malloc_size(pointer);
+#else
+		return 0;
+#endif
+	}
+
+	/// <summary>
+	/// malloc with the Semantics of operator new: retries through the new_handler
+	/// </summary>
+	void* allocate(size_t size) {
+		if (size == 0) size = 1;
+		for (;;) {
+			if (void* pointer = std::malloc(size)) {
+				Test::AllocationTracker::recordAllocation(usableSize(pointer));
+				return pointer;
+			}
+			std::new_handler handler = std::get_new_handler();
+			if (!handler) throw std::bad_alloc();
+			handler();
+		}
+	}
+
+	/// <summary>
+	/// nothrow Variant of allocate
+	/// </summary>
+	void* allocate(size_t size, const std::nothrow_t&) noexcept {
+		try {
+			return allocate(size);
+		} catch (...) {
+			return nullptr;
+		}
+	}
+
+	/// <summary>
+	/// free, recording the Deallocation
+	/// </summary>
+	void deallocate(void* pointer) noexcept {
+		if (!pointer) return;
+		Test::AllocationTracker::recordDeallocation(usableSize(pointer));
+		std::free(pointer);
+	}
+}
+
+void* operator new(size_t size) { return allocate(size); }
+void* operator new[](size_t size) { return allocate(size); }
+void* operator new(size_t size, const std::nothrow_t& tag) noexcept { return allocate(size, tag); }
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept { return allocate(size, tag); }
+
+void operator delete(void* pointer) noexcept { deallocate(pointer); }
+void operator delete[](void* pointer) noexcept { deallocate(pointer); }
+void operator delete(void* pointer, size_t) noexcept { deallocate(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { deallocate(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { deallocate(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { deallocate(pointer); }
+#endif
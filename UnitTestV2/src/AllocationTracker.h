@@ -0,0 +1,81 @@
+#pragma once
+#ifndef UT_ALLOCATION_TRACKER_H
+#define UT_ALLOCATION_TRACKER_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Test {
+
+	/// <summary>
+	/// Counts Heap Allocations per Thread.
+	/// The Counting happens in the global operator new/delete, which are only
+	/// replaced when the Framework is compiled with UT_TRACK_ALLOCATIONS defined.
+	/// Counters are thread local, so recording takes no Locks. Memory freed on
+	/// another Thread than it was allocated on is counted on the freeing Thread.
+	/// Over-aligned Allocations (std::align_val_t) are not counted.
+	/// </summary>
+	class AllocationTracker {
+	public:		//exposed Defines
+		/// <summary>
+		/// Allocation Counters, Bytes are the usable Sizes reported by the Allocator
+		/// </summary>
+		struct Statistics {
+			uint64_t mAllocations = 0;
+			uint64_t mDeallocations = 0;
+			uint64_t mBytes = 0;
+			int64_t mLive = 0;
+			int64_t mPeak = 0;
+		};
+
+	private:	//private Members
+		static thread_local Statistics tStatistics;
+
+	public:		//exposed Functionality
+		/// <summary>
+		/// Records an Allocation on the calling Thread
+		/// </summary>
+		/// <param name="size">the usable Size of the Block</param>
+		static void recordAllocation(size_t size) noexcept;
+
+		/// <summary>
+		/// Records a Deallocation on the calling Thread
+		/// </summary>
+		/// <param name="size">the usable Size of the Block</param>
+		static void recordDeallocation(size_t size) noexcept;
+
+		/// <summary>
+		/// returns the Number of Allocations made by the calling Thread so far
+		/// </summary>
+		/// <returns>the Number of Allocations</returns>
+		static uint64_t allocationCount() noexcept;
+
+		/// <summary>
+		/// Starts a Measurement on the calling Thread
+		/// </summary>
+		/// <returns>the Counters at the Start, to be passed to end</returns>
+		static Statistics begin() noexcept;
+
+		/// <summary>
+		/// Ends a Measurement on the calling Thread
+		/// </summary>
+		/// <param name="start">the Counters returned by begin</param>
+		/// <returns>the Allocations since begin, Peak is the highest Number of live Bytes above the Start</returns>
+		static Statistics end(const Statistics& start) noexcept;
+
+		/// <summary>
+		/// returns weather the global operator new/delete are replaced
+		/// </summary>
+		/// <returns>true when compiled with UT_TRACK_ALLOCATIONS</returns>
+		static constexpr bool isEnabled() {
+#if defined(UT_TRACK_ALLOCATIONS)
+			return true;
+#else
+			return false;
+#endif
+		}
+	};
+
+}
+
+#endif
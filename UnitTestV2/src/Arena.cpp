@@ -0,0 +1,87 @@
+#include "Arena.h"
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace Test {
+
+	/// <summary>
+	/// Frees all Blocks
+	/// </summary>
+	Arena::~Arena() {
+		while (mHead) {
+			Block* next = mHead->mNext;
+			std::free(mHead);
+			mHead = next;
+		}
+	}
+
+	/// <summary>
+	/// Adds a new Block to the Chain that can hold at least the given Size
+	/// </summary>
+	/// <param name="size">the Number of Bytes that have to fit</param>
+	void Arena::grow(size_t size) {
+		size_t blockSize = mHead ? mHead->mSize * 2 : mFirstBlockSize;
+		if (blockSize > mMaxBlockSize) blockSize = mMaxBlockSize;
+		if (blockSize < size) blockSize = size;
+
+		Block* block = static_cast<Block*>(std::malloc(sizeof(Block) + blockSize));
+		if (!block) throw std::bad_alloc();
+
+		block->mNext = mHead;
+		block->mSize = blockSize;
+		block->mUsed = 0;
+		mHead = block;
+	}
+
+	/// <summary>
+	/// Allocates uninitialized Memory
+	/// </summary>
+	/// <param name="size">the Number of Bytes</param>
+	/// <param name="align">the Alignment, a Power of two</param>
+	/// <returns>a Pointer to the Memory</returns>
+	void* Arena::allocate(size_t size, size_t align) {
+		for (;;) {
+			if (mHead) {
+				uintptr_t base = reinterpret_cast<uintptr_t>(mHead + 1);
+				uintptr_t address = (base + mHead->mUsed + align - 1) & ~(uintptr_t)(align - 1);
+				size_t used = address - base + size;
+				if (used <= mHead->mSize) {
+					mHead->mUsed = used;
+					return reinterpret_cast<void*>(address);
+				}
+			}
+			grow(size + align);
+		}
+	}
+
+	/// <summary>
+	/// Copies a String into the Arena
+	/// </summary>
+	/// <param name="text">the Characters to copy</param>
+	/// <param name="length">the Number of Characters</param>
+	/// <returns>the null terminated Copy</returns>
+	const char* Arena::copy(const char* text, size_t length) {
+		char* result = static_cast<char*>(allocate(length + 1, 1));
+		std::memcpy(result, text, length);
+		result[length] = '\0';
+		return result;
+	}
+
+	/// <summary>
+	/// Forgets everything allocated. The newest Block is kept for reuse,
+	/// so refilling the Arena to the same Size doesn't allocate again.
+	/// </summary>
+	void Arena::clear() {
+		if (!mHead) return;
+
+		Block* block = mHead->mNext;
+		while (block) {
+			Block* next = block->mNext;
+			std::free(block);
+			block = next;
+		}
+		mHead->mNext = nullptr;
+		mHead->mUsed = 0;
+	}
+}
@@ -0,0 +1,79 @@
+#pragma once
+#ifndef UT_ARENA_H
+#define UT_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Test {
+
+	/// <summary>
+	/// Bump Allocator for Objects living as long as the Arena.
+	/// Memory is taken from a Chain of growing Blocks and only given
+	/// back all at once, nothing allocated in it gets destructed.
+	/// </summary>
+	class Arena {
+	private:	//internal Class
+		/// <summary>
+		/// Header of a Block, the usable Memory follows directly after it
+		/// </summary>
+		struct Block {
+			Block* mNext;
+			size_t mSize;
+			size_t mUsed;
+		};
+
+	private:	//private Members
+		static constexpr size_t mFirstBlockSize = 4096;
+		static constexpr size_t mMaxBlockSize = 1 << 20;
+
+		Block* mHead = nullptr;
+
+	public:		//Constructors and Destructors
+		/// <summary>
+		/// Creates an empty Arena, the first Block is allocated on first use
+		/// </summary>
+		Arena() = default;
+
+		Arena(const Arena&) = delete;
+		Arena& operator=(const Arena&) = delete;
+
+		/// <summary>
+		/// Frees all Blocks
+		/// </summary>
+		~Arena();
+
+	private:	//internal Functionality
+		/// <summary>
+		/// Adds a new Block to the Chain that can hold at least the given Size
+		/// </summary>
+		/// <param name="size">the Number of Bytes that have to fit</param>
+		void grow(size_t size);
+
+	public:		//exposed Functionality
+		/// <summary>
+		/// Allocates uninitialized Memory
+		/// </summary>
+		/// <param name="size">the Number of Bytes</param>
+		/// <param name="align">the Alignment, a Power of two</param>
+		/// <returns>a Pointer to the Memory</returns>
+		void* allocate(size_t size, size_t align = alignof(std::max_align_t));
+
+		/// <summary>
+		/// Copies a String into the Arena
+		/// </summary>
+		/// <param name="text">the Characters to copy</param>
+		/// <param name="length">the Number of Characters</param>
+		/// <returns>the null terminated Copy</returns>
+		const char* copy(const char* text, size_t length);
+
+		/// <summary>
+		/// Forgets everything allocated. The newest Block is kept for reuse,
+		/// so refilling the Arena to the same Size doesn't allocate again.
+		/// </summary>
+		void clear();
+	};
+
+}
+
+#endif
@@ -0,0 +1,257 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace Test {
+
+	namespace {
+		/// <summary>
+		/// Most Iterations a Sample may grow to, a Body the Optimizer removed never fills the Sample Time
+		/// </summary>
+		constexpr uint64_t gMaxIterations = uint64_t(1) << 40;
+
+		/// <summary>
+		/// Pins the current Thread to a Core and restores the previous Affinity when destroyed.
+		/// A Core the Affinity Mask can't express is not pinned.
+		/// </summary>
+		class AffinityGuard {
+		private:	//private Members
+			bool mPinned = false;
+#if defined(_WIN32)
+			DWORD_PTR mPrevious = 0;
+#elif defined(__linux__)
+			cpu_set_t mPrevious;
+#endif
+
+		public:		//Constructors and Destructors
+			explicit AffinityGuard(int core) {
+				if (core < 0) return;
+#if defined(_WIN32)
+				if (core >= static_cast<int>(sizeof(DWORD_PTR) * 8)) return;
+				mPrevious = SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << core);
+				mPinned = mPrevious != 0;
+#elif defined(__linux__)
+				if (core >= CPU_SETSIZE) return;
+				if (pthread_getaffinity_np(pthread_self(), sizeof(mPrevious), &mPrevious) != 0) return;
+				cpu_set_t set;
+				CPU_ZERO(&set);
+				CPU_SET(core, &set);
+				mPinned = pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#endif
+			}
+
+			~AffinityGuard() {
+				if (!mPinned) return;
+#if defined(_WIN32)
+				SetThreadAffinityMask(GetCurrentThread(), mPrevious);
+#elif defined(__linux__)
+				pthread_setaffinity_np(pthread_self(), sizeof(mPrevious), &mPrevious);
+#endif
+			}
+		};
+	}
+
+	/// <summary>
+	/// reads the Pointer in a separate Translation Unit, so the Compiler
+	/// has to assume the pointed to Value is used
+	/// </summary>
+	/// <param name="pointer">the Pointer to the Value</param>
+	void useCharPointer(const volatile char*) {}
+
+
+	/// <summary>
+	/// Creates the Benchmark and registers it with the Framework,
+	/// tagged "benchmark" so a quick Run can skip it with --exclude-tag benchmark
+	/// </summary>
+	/// <param name="name">the Name of the Benchmark</param>
+	Benchmark::Benchmark(const std::string& name) : Testable(name) {
+		tag("benchmark");
+	}
+
+	/// <summary>
+	/// Times a single Sample
+	/// </summary>
+	/// <param name="iterations">the Number of Iterations in the Sample</param>
+	/// <returns>the Duration of the Sample in Nanoseconds</returns>
+	double Benchmark::sample(uint64_t iterations) {
+		timepoint start = clock::now();
+		measure(iterations);
+		clobberMemory();
+		timepoint end = clock::now();
+		return std::chrono::duration<double, std::nano>(end - start).count();
+	}
+
+	/// <summary>
+	/// Finds the Number of Iterations that fill the Sample Time,
+	/// stops at the Iteration Cap or when the Test is asked to stop
+	/// </summary>
+	/// <returns>the Number of Iterations per Sample</returns>
+	uint64_t Benchmark::calibrate() {
+		const double target = std::chrono::duration<double, std::nano>(mSampleTime).count();
+		uint64_t iterations = 1;
+
+		for (;;) {
+			double time = sample(iterations);
+			if (time >= target || iterations >= gMaxIterations || shouldStop()) return iterations;
+
+			//grow towards the target, but at most tenfold so one slow sample can't overshoot
+			double factor = time > 0 ? target / time * 1.2 : 10.0;
+			factor = std::min(std::max(factor, 2.0), 10.0);
+
+			//compared as double, the cast is only done once the value is known to fit
+			double next = static_cast<double>(iterations) * factor;
+			iterations = next >= static_cast<double>(gMaxIterations) ? gMaxIterations : static_cast<uint64_t>(next);
+		}
+	}
+
+	/// <summary>
+	/// Computes the Statistics from the measured Samples
+	/// </summary>
+	void Benchmark::evaluate() {
+		std::vector<double> sorted = mSamples;
+		std::sort(sorted.begin(), sorted.end());
+
+		size_t count = sorted.size();
+		double sum = 0;
+		for (double value : sorted) sum += value;
+		double mean = sum / count;
+
+		double squares = 0;
+		for (double value : sorted) squares += (value - mean) * (value - mean);
+
+		mStatistics.mMin = sorted.front();
+		mStatistics.mMedian = count % 2 ? sorted[count / 2] : (sorted[count / 2 - 1] + sorted[count / 2]) / 2;
+		mStatistics.mP99 = sorted[std::min(count - 1, static_cast<size_t>(std::ceil(count * 0.99)) - 1)];
+		mStatistics.mMean = mean;
+		mStatistics.mStdDev = count > 1 ? std::sqrt(squares / (count - 1)) : 0;
+		mStatistics.mSamples = static_cast<uint32_t>(count);
+	}
+
+	/// <summary>
+	/// Calibrates, warms up and takes the Samples
+	/// </summary>
+	void Benchmark::run() {
+		AffinityGuard affinity(mCore);
+
+		uint64_t iterations = calibrate();
+		for (uint32_t i = 0; i < mWarmupCount && !shouldStop(); i++)
+			sample(iterations);
+
+		//a stopped benchmark is evaluated with the samples taken so far
+		mSamples.clear();
+		for (uint32_t i = 0; i < mSampleCount && !shouldStop(); i++)
+			mSamples.push_back(sample(iterations) / iterations);
+
+		mStatistics.mIterations = iterations;
+		if (!mSamples.empty()) evaluate();
+	}
+
+	/// <summary>
+	/// Benchmarks must not share the CPU with other Tests
+	/// </summary>
+	/// <returns>always true</returns>
+	bool Benchmark::isExclusive() const {
+		return true;
+	}
+
+	/// <summary>
+	/// Writes the Statistics to the Report
+	/// </summary>
+	/// <param name="stream">the stream to write to</param>
+	/// <param name="indent">the Width of the Labels</param>
+	void Benchmark::reportDetails(std::ostream& stream, uint32_t indent) const {
+		if (mStatistics.mSamples == 0) return;
+
+		stream
+			<< std::setw(indent) << std::left << "Samples: "
+			<< mStatistics.mSamples << " x " << mStatistics.mIterations << " iterations\n"
+			<< std::setw(indent) << std::left << "ns/op: " << mStatistics.mMedian << '\n'
+			<< std::setw(indent) << std::left << "Min: " << mStatistics.mMin << "ns\n"
+			<< std::setw(indent) << std::left << "P99: " << mStatistics.mP99 << "ns\n"
+			<< std::setw(indent) << std::left << "StdDev: " << mStatistics.mStdDev << "ns\n";
+	}
+
+	/// <summary>
+	/// Writes the Outcome and the Statistics to a Message
+	/// </summary>
+	/// <param name="writer">the Message to write to</param>
+	void Benchmark::saveState(MessageWriter& writer) const {
+		Testable::saveState(writer);
+		writer.write(mStatistics);
+	}
+
+	/// <summary>
+	/// Reads the Outcome and the Statistics from a Message
+	/// </summary>
+	/// <param name="reader">the Message to read from</param>
+	/// <returns>false when the Message is malformed</returns>
+	bool Benchmark::loadState(MessageReader& reader) {
+		return Testable::loadState(reader) && reader.read(mStatistics);
+	}
+
+	/// <summary>
+	/// Forgets the Samples and Statistics of the last Run
+	/// </summary>
+	void Benchmark::reset() {
+		Testable::reset();
+		//keeps the capacity, the next run takes as many samples
+		mSamples.clear();
+		mStatistics = Statistics();
+	}
+
+	/// <summary>
+	/// Sets the Number of measured Samples and Warmup Samples
+	/// </summary>
+	/// <param name="samples">the Number of measured Samples</param>
+	/// <param name="warmup">the Number of Samples thrown away first</param>
+	void Benchmark::setSamples(uint32_t samples, uint32_t warmup) {
+		mSampleCount = samples > 0 ? samples : 1;
+		mWarmupCount = warmup;
+	}
+
+	/// <summary>
+	/// Sets the Time a single Sample should take at least
+	/// </summary>
+	/// <param name="milliseconds">the Time in Milliseconds</param>
+	void Benchmark::setSampleTime(double milliseconds) {
+		mSampleTime = duration(milliseconds);
+	}
+
+	/// <summary>
+	/// Pins the Thread to a CPU Core while the Benchmark runs
+	/// </summary>
+	/// <param name="core">the Index of the Core, -1 to not pin, a Core beyond the Affinity Mask is ignored</param>
+	void Benchmark::pinToCore(int core) {
+		mCore = core;
+	}
+
+	/// <summary>
+	/// returns the Statistics of the last Run
+	/// </summary>
+	/// <returns>the Statistics</returns>
+	const Benchmark::Statistics& Benchmark::getStatistics() const {
+		return mStatistics;
+	}
+
+	/// <summary>
+	/// Returns the Timing compared against the Baseline
+	/// </summary>
+	/// <returns>the median Nanoseconds per Iteration over all Samples</returns>
+	Timing Benchmark::getTiming() const {
+		Timing timing;
+		timing.mMean = mStatistics.mMedian;
+		timing.mStdDev = mStatistics.mStdDev;
+		timing.mSamples = mStatistics.mSamples;
+		return timing;
+	}
+}
@@ -0,0 +1,202 @@
+#pragma once
+#ifndef UT_BENCHMARK_H
+#define UT_BENCHMARK_H
+
+#include <vector>
+#include "Testable.h"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace Test {
+
+	/// <summary>
+	/// reads the Pointer in a separate Translation Unit, so the Compiler
+	/// has to assume the pointed to Value is used
+	/// </summary>
+	/// <param name="pointer">the Pointer to the Value</param>
+	void useCharPointer(const volatile char* pointer);
+
+#if defined(_MSC_VER) && !defined(__clang__)
+	/// <summary>
+	/// Forces the Compiler to compute the Value, even if it is never used
+	/// </summary>
+	/// <param name="value">the Value to keep</param>
+	template<typename T>
+	inline void doNotOptimize(const T& value) {
+		useCharPointer(&reinterpret_cast<const volatile char&>(value));
+		_ReadWriteBarrier();
+	}
+
+	/// <summary>
+	/// Forces all pending Writes to Memory to actually happen
+	/// </summary>
+	inline void clobberMemory() {
+		_ReadWriteBarrier();
+	}
+#else
+	/// <summary>
+	/// Forces the Compiler to compute the Value, even if it is never used
+	/// </summary>
+	/// <param name="value">the Value to keep</param>
+	template<typename T>
+	inline void doNotOptimize(const T& value) {
+		asm volatile("" : : "r,m"(value) : "memory");
+	}
+
+	/// <summary>
+	/// Forces the Compiler to compute the Value and to assume it was changed
+	/// </summary>
+	/// <param name="value">the Value to keep</param>
+	template<typename T>
+	inline void doNotOptimize(T& value) {
+		asm volatile("" : "+r,m"(value) : : "memory");
+	}
+
+	/// <summary>
+	/// Forces all pending Writes to Memory to actually happen
+	/// </summary>
+	inline void clobberMemory() {
+		asm volatile("" : : : "memory");
+	}
+#endif
+
+	/// <summary>
+	/// A Test measuring the Time a piece of Code takes.
+	/// The Iteration Count is calibrated until a Sample takes long enough
+	/// to be measured reliably (at most 2^40 Iterations), then Warmup and measured Samples are taken.
+	/// Benchmarks run alone, after all other Tests have finished.
+	/// </summary>
+	class Benchmark : public Testable {
+	public:		//exposed Defines
+		/// <summary>
+		/// Statistics over all measured Samples, Times are in Nanoseconds per Iteration
+		/// </summary>
+		struct Statistics {
+			double mMin = 0;
+			double mMedian = 0;
+			double mP99 = 0;
+			double mMean = 0;
+			double mStdDev = 0;
+			uint64_t mIterations = 0;
+			uint32_t mSamples = 0;
+		};
+
+	private:	//private Members
+		uint32_t mSampleCount = 20;
+		uint32_t mWarmupCount = 2;
+		duration mSampleTime = duration(10);
+		int mCore = -1;
+
+		std::vector<double> mSamples;
+		Statistics mStatistics;
+
+	public:		//Constructors and Destructors
+		/// <summary>
+		/// Creates the Benchmark and registers it with the Framework,
+		/// tagged "benchmark" so a quick Run can skip it with --exclude-tag benchmark
+		/// </summary>
+		/// <param name="name">the Name of the Benchmark</param>
+		Benchmark(const std::string& name);
+
+	private:	//internal Functionality
+		/// <summary>
+		/// Times a single Sample
+		/// </summary>
+		/// <param name="iterations">the Number of Iterations in the Sample</param>
+		/// <returns>the Duration of the Sample in Nanoseconds</returns>
+		double sample(uint64_t iterations);
+
+		/// <summary>
+		/// Finds the Number of Iterations that fill the Sample Time,
+		/// stops at the Iteration Cap or when the Test is asked to stop
+		/// </summary>
+		/// <returns>the Number of Iterations per Sample</returns>
+		uint64_t calibrate();
+
+		/// <summary>
+		/// Computes the Statistics from the measured Samples
+		/// </summary>
+		void evaluate();
+
+	protected:	//protected Functionality
+		/// <summary>
+		/// Runs the measured Code the given Number of Times.
+		/// Use doNotOptimize on Results so the Loop isn't optimized away.
+		/// </summary>
+		/// <param name="iterations">the Number of Iterations</param>
+		virtual void measure(uint64_t iterations) = 0;
+
+		/// <summary>
+		/// Calibrates, warms up and takes the Samples
+		/// </summary>
+		void run() override final;
+
+		/// <summary>
+		/// Benchmarks must not share the CPU with other Tests
+		/// </summary>
+		/// <returns>always true</returns>
+		bool isExclusive() const override;
+
+		/// <summary>
+		/// Writes the Statistics to the Report
+		/// </summary>
+		/// <param name="stream">the stream to write to</param>
+		/// <param name="indent">the Width of the Labels</param>
+		void reportDetails(std::ostream& stream, uint32_t indent) const override;
+
+		/// <summary>
+		/// Writes the Outcome and the Statistics to a Message
+		/// </summary>
+		/// <param name="writer">the Message to write to</param>
+		void saveState(MessageWriter& writer) const override;
+
+		/// <summary>
+		/// Reads the Outcome and the Statistics from a Message
+		/// </summary>
+		/// <param name="reader">the Message to read from</param>
+		/// <returns>false when the Message is malformed</returns>
+		bool loadState(MessageReader& reader) override;
+
+		/// <summary>
+		/// Forgets the Samples and Statistics of the last Run
+		/// </summary>
+		void reset() override;
+
+	public:		//Getters and Setters
+		/// <summary>
+		/// Sets the Number of measured Samples and Warmup Samples
+		/// </summary>
+		/// <param name="samples">the Number of measured Samples</param>
+		/// <param name="warmup">the Number of Samples thrown away first</param>
+		void setSamples(uint32_t samples, uint32_t warmup = 2);
+
+		/// <summary>
+		/// Sets the Time a single Sample should take at least
+		/// </summary>
+		/// <param name="milliseconds">the Time in Milliseconds</param>
+		void setSampleTime(double milliseconds);
+
+		/// <summary>
+		/// Pins the Thread to a CPU Core while the Benchmark runs
+		/// </summary>
+		/// <param name="core">the Index of the Core, -1 to not pin, a Core beyond the Affinity Mask is ignored</param>
+		void pinToCore(int core);
+
+		/// <summary>
+		/// returns the Statistics of the last Run
+		/// </summary>
+		/// <returns>the Statistics</returns>
+		const Statistics& getStatistics() const;
+
+		/// <summary>
+		/// Returns the Timing compared against the Baseline
+		/// </summary>
+		/// <returns>the median Nanoseconds per Iteration over all Samples</returns>
+		Timing getTiming() const override;
+	};
+
+}
+
+#endif
@@ -0,0 +1,27 @@
+#include "BufferedFile.h"
+
+namespace Test {
+	namespace {
+		constexpr size_t gBufferSize = 1 << 16;
+	}
+
+
+	/// <summary>
+	/// Creates the File, replacing an existing one
+	/// </summary>
+	/// <param name="path">the File to write</param>
+	BufferedFile::BufferedFile(const std::string& path) : mBuffer(new char[gBufferSize]), mPath(path) {
+		//the buffer has to be set before the file is opened
+		rdbuf()->pubsetbuf(mBuffer.get(), gBufferSize);
+		open(mPath, std::ios::binary);
+	}
+
+	/// <summary>
+	/// Throws away everything written so far and starts the File over
+	/// </summary>
+	void BufferedFile::rewrite() {
+		//closing keeps the buffer, the file buffer only drops buffers it allocated itself
+		close();
+		open(mPath, std::ios::binary | std::ios::trunc);
+	}
+}
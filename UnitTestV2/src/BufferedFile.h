@@ -0,0 +1,38 @@
+#pragma once
+#ifndef UT_BUFFERED_FILE_H
+#define UT_BUFFERED_FILE_H
+
+#include <fstream>
+#include <memory>
+#include <string>
+
+namespace Test {
+
+	/// <summary>
+	/// Binary Output File with a large Buffer, so Reporters writing an Event
+	/// at a Time don't make a System Call for every Line.
+	/// </summary>
+	class BufferedFile : public std::ofstream {
+	private:	//private Members
+		std::unique_ptr<char[]> mBuffer;
+		std::string mPath;
+
+	public:		//Constructors and Destructors
+		/// <summary>
+		/// Creates the File, replacing an existing one
+		/// </summary>
+		/// <param name="path">the File to write</param>
+		explicit BufferedFile(const std::string& path);
+
+		BufferedFile(const BufferedFile&) = delete;
+
+	public:		//exposed Functionality
+		/// <summary>
+		/// Throws away everything written so far and starts the File over
+		/// </summary>
+		void rewrite();
+	};
+
+}
+
+#endif
@@ -0,0 +1,154 @@
+#include "DataFile.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Test {
+
+	/// <summary>
+	/// Maps a File into Memory
+	/// </summary>
+	/// <param name="path">the File to map</param>
+	DataFile::DataFile(const std::string& path) {
+#if defined(_WIN32)
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE) return;
+		mFile = file;
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size)) return;
+		mSize = static_cast<size_t>(size.QuadPart);
+
+		//an empty file can't be mapped, but is a valid table without rows
+		if (mSize == 0) {
+			mData = "";
+			return;
+		}
+
+		mMapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!mMapping) return;
+		mData = static_cast<const char*>(MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0));
+#else
+		mFile = open(path.c_str(), O_RDONLY);
+		if (mFile < 0) return;
+
+		struct stat info;
+		if (fstat(mFile, &info) != 0) return;
+		mSize = static_cast<size_t>(info.st_size);
+
+		//an empty file can't be mapped, but is a valid table without rows
+		if (mSize == 0) {
+			mData = "";
+			return;
+		}
+
+		void* data = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, mFile, 0);
+		if (data == MAP_FAILED) return;
+		mData = static_cast<const char*>(data);
+#endif
+	}
+
+	/// <summary>
+	/// Unmaps the File
+	/// </summary>
+	DataFile::~DataFile() {
+#if defined(_WIN32)
+		if (mData && mSize > 0) UnmapViewOfFile(mData);
+		if (mMapping) CloseHandle(mMapping);
+		if (mFile) CloseHandle(mFile);
+#else
+		if (mData && mSize > 0) munmap(const_cast<char*>(mData), mSize);
+		if (mFile >= 0) close(mFile);
+#endif
+	}
+
+	/// <summary>
+	/// Finds the Start of every Line
+	/// </summary>
+	void DataFile::indexLines() {
+		if (!mData) return;
+
+		const char* end = mData + mSize;
+		for (const char* line = mData; line < end;) {
+			mLines.push_back(static_cast<size_t>(line - mData));
+			const char* next = static_cast<const char*>(std::memchr(line, '\n', end - line));
+			line = next ? next + 1 : end;
+		}
+		mLines.push_back(mSize);
+	}
+
+	/// <summary>
+	/// returns weather the File could be mapped
+	/// </summary>
+	/// <returns>true when the File is mapped, an empty File counts as mapped</returns>
+	bool DataFile::isOpen() const {
+		return mData != nullptr;
+	}
+
+	/// <summary>
+	/// Returns the Contents of the File
+	/// </summary>
+	/// <returns>the first Byte of the File</returns>
+	const char* DataFile::data() const {
+		return mData;
+	}
+
+	/// <summary>
+	/// Returns the Size of the File
+	/// </summary>
+	/// <returns>the Size in Bytes</returns>
+	size_t DataFile::size() const {
+		return mSize;
+	}
+
+	/// <summary>
+	/// Returns the Number of Lines
+	/// </summary>
+	/// <returns>the Number of Lines, a last Line without Newline counts</returns>
+	size_t DataFile::lineCount() {
+		std::call_once(mIndexed, &DataFile::indexLines, this);
+		return mLines.empty() ? 0 : mLines.size() - 1;
+	}
+
+	/// <summary>
+	/// Returns a Line without its Line Break
+	/// </summary>
+	/// <param name="index">the Index of the Line, below lineCount</param>
+	/// <returns>the Line, pointing into the mapped File</returns>
+	std::string_view DataFile::line(size_t index) {
+		std::call_once(mIndexed, &DataFile::indexLines, this);
+		size_t begin = mLines[index];
+		size_t end = mLines[index + 1];
+		if (end > begin && mData[end - 1] == '\n') end--;
+		if (end > begin && mData[end - 1] == '\r') end--;
+		return std::string_view(mData + begin, end - begin);
+	}
+
+	/// <summary>
+	/// Splits a Line into its Fields, like the Cells of a CSV Row
+	/// </summary>
+	/// <param name="line">the Line</param>
+	/// <param name="separator">the Character between the Fields</param>
+	/// <returns>the Fields, pointing into the Line</returns>
+	std::vector<std::string_view> DataFile::fields(std::string_view line, char separator) {
+		std::vector<std::string_view> result;
+		size_t begin = 0;
+		for (;;) {
+			size_t end = line.find(separator, begin);
+			if (end == std::string_view::npos) {
+				result.push_back(line.substr(begin));
+				return result;
+			}
+			result.push_back(line.substr(begin, end - begin));
+			begin = end + 1;
+		}
+	}
+}
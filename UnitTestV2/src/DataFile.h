@@ -0,0 +1,125 @@
+#pragma once
+#ifndef UT_DATAFILE_H
+#define UT_DATAFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace Test {
+
+	/// <summary>
+	/// Read only File mapped into Memory, as a Source of Test Parameters.
+	/// The Pages are only read when a Case touches them, so Tables far larger
+	/// than the Memory can be used. Text Files are read by Line, binary Files
+	/// as an Array of fixed Size Records.
+	/// </summary>
+	class DataFile {
+	private:	//private Members
+		const char* mData = nullptr;
+		size_t mSize = 0;
+#if defined(_WIN32)
+		void* mFile = nullptr;
+		void* mMapping = nullptr;
+#else
+		int mFile = -1;
+#endif
+
+		std::once_flag mIndexed;
+		std::vector<size_t> mLines;
+
+	public:		//Constructors and Destructors
+		/// <summary>
+		/// Maps a File into Memory
+		/// </summary>
+		/// <param name="path">the File to map</param>
+		explicit DataFile(const std::string& path);
+
+		DataFile(const DataFile&) = delete;
+
+		/// <summary>
+		/// Unmaps the File
+		/// </summary>
+		~DataFile();
+
+	private:	//internal functionality
+		/// <summary>
+		/// Finds the Start of every Line
+		/// </summary>
+		void indexLines();
+
+	public:		//exposed Functionality
+		/// <summary>
+		/// returns weather the File could be mapped
+		/// </summary>
+		/// <returns>true when the File is mapped, an empty File counts as mapped</returns>
+		bool isOpen() const;
+
+		/// <summary>
+		/// Returns the Contents of the File
+		/// </summary>
+		/// <returns>the first Byte of the File</returns>
+		const char* data() const;
+
+		/// <summary>
+		/// Returns the Size of the File
+		/// </summary>
+		/// <returns>the Size in Bytes</returns>
+		size_t size() const;
+
+		/// <summary>
+		/// Returns the Number of Lines. The Lines are indexed on the first Call,
+		/// any Thread may call it.
+		/// </summary>
+		/// <returns>the Number of Lines, a last Line without Newline counts</returns>
+		size_t lineCount();
+
+		/// <summary>
+		/// Returns a Line without its Line Break
+		/// </summary>
+		/// <param name="index">the Index of the Line, below lineCount</param>
+		/// <returns>the Line, pointing into the mapped File</returns>
+		std::string_view line(size_t index);
+
+		/// <summary>
+		/// Splits a Line into its Fields, like the Cells of a CSV Row
+		/// </summary>
+		/// <param name="line">the Line</param>
+		/// <param name="separator">the Character between the Fields</param>
+		/// <returns>the Fields, pointing into the Line</returns>
+		static std::vector<std::string_view> fields(std::string_view line, char separator = ',');
+
+		/// <summary>
+		/// Returns the Number of whole Records in a binary File
+		/// </summary>
+		/// <typeparam name="T">the Type of a Record</typeparam>
+		/// <returns>the Number of Records</returns>
+		template<typename T>
+		size_t recordCount() const {
+			return mSize / sizeof(T);
+		}
+
+		/// <summary>
+		/// Reads a Record of a binary File. The Record is copied, so the
+		/// File needn't be aligned for T.
+		/// </summary>
+		/// <typeparam name="T">the Type of a Record, trivially copyable</typeparam>
+		/// <param name="index">the Index of the Record, below recordCount</param>
+		/// <returns>the Record</returns>
+		template<typename T>
+		T record(size_t index) const {
+			static_assert(std::is_trivially_copyable<T>::value, "records are copied byte by byte");
+			T value;
+			std::memcpy(&value, mData + index * sizeof(T), sizeof(T));
+			return value;
+		}
+	};
+
+}
+
+#endif
@@ -0,0 +1,90 @@
+#include "Fixture.h"
+#include <chrono>
+#include <exception>
+
+namespace Test {
+
+	/// <summary>
+	/// Creates the Fixture without building it
+	/// </summary>
+	/// <param name="name">the Name shown in the Report</param>
+	FixtureBase::FixtureBase(const std::string& name) : mName(name) {}
+
+	/// <summary>
+	/// Builds the Fixture unless it is built already
+	/// </summary>
+	/// <returns>false when the Build failed</returns>
+	bool FixtureBase::acquire() {
+		if (mReady.load(std::memory_order_acquire)) return true;
+
+		std::lock_guard<std::mutex> lock(mMutex);
+		if (mReady.load(std::memory_order_relaxed)) return true;
+		//a failed build isn't retried by every other test
+		if (!mError.empty()) return false;
+
+		auto start = std::chrono::steady_clock::now();
+		try {
+			build();
+		} catch (std::exception& e) {
+			mError = e.what();
+		} catch (...) {
+			mError = "Unknown Error";
+		}
+		if (!mError.empty()) {
+			//the build may have thrown halfway through
+			try {
+				teardown();
+			} catch (...) {}
+			return false;
+		}
+		mBuildTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		mReady.store(true, std::memory_order_release);
+		return true;
+	}
+
+	/// <summary>
+	/// Tells the Fixture that a Test using it finished,
+	/// the last one tears it down
+	/// </summary>
+	void FixtureBase::release() {
+		if (mPending.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+		close();
+	}
+
+	/// <summary>
+	/// Tears the Fixture down if it is built, no matter how many Tests still need it
+	/// </summary>
+	void FixtureBase::close() {
+		std::lock_guard<std::mutex> lock(mMutex);
+		if (!mReady.load(std::memory_order_relaxed)) return;
+		mReady.store(false, std::memory_order_relaxed);
+		try {
+			teardown();
+		} catch (...) {}
+	}
+
+	/// <summary>
+	/// Getter for the Name of the Fixture
+	/// </summary>
+	/// <returns>the Name of the Fixture</returns>
+	const std::string& FixtureBase::getName() const {
+		return mName;
+	}
+
+	/// <summary>
+	/// Returns the Error that made the Build fail
+	/// </summary>
+	/// <returns>the Error, empty when the Build didn't fail</returns>
+	const std::string& FixtureBase::getError() const {
+		return mError;
+	}
+
+	/// <summary>
+	/// Returns the Time the Build took
+	/// </summary>
+	/// <returns>the Time in Milliseconds, 0 when it wasn't built</returns>
+	double FixtureBase::getBuildTime() const {
+		return mBuildTime;
+	}
+}
@@ -0,0 +1,155 @@
+#pragma once
+#ifndef UT_FIXTURE_H
+#define UT_FIXTURE_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace Test {
+
+	class TestCollection;
+
+	/// <summary>
+	/// An expensive Environment shared by several Tests, declared once for the Suite.
+	/// It is built by the first Test that needs it, on whichever Worker runs that
+	/// Test, and torn down when the last Test using it finished. Tests declare
+	/// their Fixtures with Testable::uses. In Worker Processes every Worker
+	/// builds its own Copy and tears it down before it exits.
+	/// </summary>
+	class FixtureBase {
+		friend TestCollection;
+	private:	//private Members
+		std::string mName;
+		std::mutex mMutex;
+		std::atomic<bool> mReady{ false };
+		std::string mError;
+
+		std::atomic<uint64_t> mPending{ 0 };
+		uint64_t mUsers = 0;
+		double mBuildTime = 0;
+
+	public:		//Constructors and Destructors
+		/// <summary>
+		/// Creates the Fixture without building it
+		/// </summary>
+		/// <param name="name">the Name shown in the Report</param>
+		explicit FixtureBase(const std::string& name);
+
+		FixtureBase(const FixtureBase&) = delete;
+
+		virtual ~FixtureBase() = default;
+
+	protected:	//protected functionality (to get overrides from childclasses)
+		/// <summary>
+		/// Builds the Environment
+		/// </summary>
+		virtual void build() = 0;
+
+		/// <summary>
+		/// Destroys the Environment
+		/// </summary>
+		virtual void teardown() = 0;
+
+	public:		//exposed Functionality
+		/// <summary>
+		/// Builds the Fixture unless it is built already. Other Threads
+		/// needing it meanwhile wait for the Build.
+		/// </summary>
+		/// <returns>false when the Build failed</returns>
+		bool acquire();
+
+		/// <summary>
+		/// Tells the Fixture that a Test using it finished,
+		/// the last one tears it down
+		/// </summary>
+		void release();
+
+		/// <summary>
+		/// Tears the Fixture down if it is built, no matter how many Tests
+		/// still need it. Called by Worker Processes before they exit, as
+		/// every Worker runs only some of the Tests counted as pending.
+		/// </summary>
+		void close();
+
+	public:		//getters and setters
+		/// <summary>
+		/// Getter for the Name of the Fixture
+		/// </summary>
+		/// <returns>the Name of the Fixture</returns>
+		const std::string& getName() const;
+
+		/// <summary>
+		/// Returns the Error that made the Build fail
+		/// </summary>
+		/// <returns>the Error, empty when the Build didn't fail</returns>
+		const std::string& getError() const;
+
+		/// <summary>
+		/// Returns the Time the Build took
+		/// </summary>
+		/// <returns>the Time in Milliseconds, 0 when it wasn't built</returns>
+		double getBuildTime() const;
+	};
+
+	/// <summary>
+	/// A Fixture holding a Value of Type T, read only to the Tests
+	/// </summary>
+	/// <typeparam name="T">the Type of the Environment</typeparam>
+	template<typename T>
+	class Fixture : public FixtureBase {
+	public:		//definitions
+		typedef std::function<std::unique_ptr<T>()> factory;
+
+	private:	//private Members
+		factory mFactory;
+		std::unique_ptr<T> mValue;
+
+	public:		//Constructors and Destructors
+		/// <summary>
+		/// Creates the Fixture, the Factory is called when a Test first needs it
+		/// </summary>
+		/// <param name="name">the Name shown in the Report</param>
+		/// <param name="create">builds the Value, may throw</param>
+		Fixture(const std::string& name, factory create) : FixtureBase(name), mFactory(std::move(create)) {}
+
+		/// <summary>
+		/// Creates the Fixture, the Value is default constructed when a Test first needs it
+		/// </summary>
+		/// <param name="name">the Name shown in the Report</param>
+		explicit Fixture(const std::string& name) : Fixture(name, []() { return std::unique_ptr<T>(new T()); }) {}
+
+	protected:	//protected functionality
+		/// <summary>
+		/// Builds the Value
+		/// </summary>
+		void build() override {
+			mValue = mFactory();
+		}
+
+		/// <summary>
+		/// Destroys the Value
+		/// </summary>
+		void teardown() override {
+			mValue.reset();
+		}
+
+	public:		//getters and setters
+		/// <summary>
+		/// Returns the Value, only valid while a Test using the Fixture runs
+		/// </summary>
+		/// <returns>the Value</returns>
+		const T& get() const {
+			return *mValue;
+		}
+
+		const T* operator->() const {
+			return mValue.get();
+		}
+	};
+
+}
+
+#endif
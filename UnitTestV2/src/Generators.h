@@ -0,0 +1,235 @@
+#pragma once
+#ifndef UT_GENERATORS_H
+#define UT_GENERATORS_H
+
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Test {
+
+	/// <summary>
+	/// Random Engine of the Property Tests. Its Sequence is defined by the
+	/// Standard, so a Seed reproduces the same Cases on every Platform.
+	/// </summary>
+	typedef std::mt19937_64 Random;
+
+	/// <summary>
+	/// Produces random Values of a Type and simpler Variants of a Value
+	/// </summary>
+	/// <typeparam name="T">the Type of the Values</typeparam>
+	template<typename T>
+	struct Generator {
+		typedef T value_type;
+
+		//returns a random Value
+		std::function<T(Random&)> mGenerate;
+
+		//returns simpler Values to try when the Value broke a Property, simplest first
+		std::function<std::vector<T>(const T&)> mShrink;
+	};
+
+	namespace Generators {
+
+		/// <summary>
+		/// returns a uniformly distributed Number in [0, range]. Unlike the
+		/// std Distributions the Result is the same with every Standard Library.
+		/// </summary>
+		/// <param name="random">the Random Engine</param>
+		/// <param name="range">the largest Number</param>
+		/// <returns>the Number</returns>
+		inline uint64_t below(Random& random, uint64_t range) {
+			if (range == std::numeric_limits<uint64_t>::max()) return random();
+			return random() % (range + 1);
+		}
+
+		/// <summary>
+		/// Integers in [min, max], shrunk towards the Value closest to 0
+		/// </summary>
+		/// <typeparam name="T">the Integer Type</typeparam>
+		/// <param name="min">the smallest Value</param>
+		/// <param name="max">the largest Value</param>
+		/// <returns>the Generator</returns>
+		template<typename T>
+		Generator<T> integer(T min = std::numeric_limits<T>::min(), T max = std::numeric_limits<T>::max()) {
+			static_assert(std::is_integral<T>::value, "integer needs an integral type");
+			T target = min > 0 ? min : max < 0 ? max : T(0);
+
+			Generator<T> generator;
+			generator.mGenerate = [min, max](Random& random) {
+				uint64_t range = static_cast<uint64_t>(max) - static_cast<uint64_t>(min);
+				return static_cast<T>(static_cast<uint64_t>(min) + below(random, range));
+			};
+			generator.mShrink = [target](const T& value) {
+				//the target, then halfway there and ever closer to the value
+				std::vector<T> candidates;
+				if (value == target) return candidates;
+				candidates.push_back(target);
+				T distance = value - target;
+				for (T step = distance / 2; step != 0; step /= 2)
+					candidates.push_back(value - step);
+				return candidates;
+			};
+			return generator;
+		}
+
+		/// <summary>
+		/// Floating Point Numbers in [min, max), shrunk towards the Value closest
+		/// to 0 and to whole Numbers
+		/// </summary>
+		/// <typeparam name="T">the floating Point Type</typeparam>
+		/// <param name="min">the smallest Value</param>
+		/// <param name="max">the Bound of the Values</param>
+		/// <returns>the Generator</returns>
+		template<typename T>
+		Generator<T> real(T min, T max) {
+			static_assert(std::is_floating_point<T>::value, "real needs a floating point type");
+			T target = min > 0 ? min : max < 0 ? max : T(0);
+
+			Generator<T> generator;
+			generator.mGenerate = [min, max](Random& random) {
+				//53 random bits fill the mantissa of a double
+				T unit = static_cast<T>((random() >> 11) * (1.0 / 9007199254740992.0));
+				return min + (max - min) * unit;
+			};
+			generator.mShrink = [target](const T& value) {
+				std::vector<T> candidates;
+				if (value == target) return candidates;
+				candidates.push_back(target);
+				T whole = std::trunc(value);
+				if (whole != value && whole != target) candidates.push_back(whole);
+				T half = target + (value - target) / 2;
+				if (half != value && half != target) candidates.push_back(half);
+				return candidates;
+			};
+			return generator;
+		}
+
+		/// <summary>
+		/// true or false, shrunk towards false
+		/// </summary>
+		/// <returns>the Generator</returns>
+		inline Generator<bool> boolean() {
+			Generator<bool> generator;
+			generator.mGenerate = [](Random& random) { return (random() & 1) != 0; };
+			generator.mShrink = [](const bool& value) {
+				return value ? std::vector<bool>{ false } : std::vector<bool>();
+			};
+			return generator;
+		}
+
+		/// <summary>
+		/// One of the given Values, shrunk towards the first. Throws std::invalid_argument without Values
+		/// </summary>
+		/// <typeparam name="T">the Type of the Values</typeparam>
+		/// <param name="values">the Values to choose from, not empty</param>
+		/// <returns>the Generator</returns>
+		template<typename T>
+		Generator<T> oneOf(std::vector<T> values) {
+			//there is no value to draw, and size() - 1 would wrap around
+			if (values.empty()) throw std::invalid_argument("oneOf needs at least one Value");
+			auto shared = std::make_shared<const std::vector<T>>(std::move(values));
+
+			Generator<T> generator;
+			generator.mGenerate = [shared](Random& random) {
+				return (*shared)[below(random, shared->size() - 1)];
+			};
+			generator.mShrink = [shared](const T& value) {
+				std::vector<T> candidates;
+				for (const T& candidate : *shared) {
+					if (candidate == value) break;
+					candidates.push_back(candidate);
+				}
+				return candidates;
+			};
+			return generator;
+		}
+
+		/// <summary>
+		/// Simpler Variants of a Sequence: shorter ones first, then ones with simpler Elements
+		/// </summary>
+		/// <typeparam name="C">the Type of the Sequence</typeparam>
+		/// <typeparam name="T">the Type of the Elements</typeparam>
+		/// <param name="value">the Sequence</param>
+		/// <param name="element">the Generator of the Elements</param>
+		/// <returns>the Variants, simplest first</returns>
+		template<typename C, typename T>
+		std::vector<C> shrinkSequence(const C& value, const Generator<T>& element) {
+			std::vector<C> candidates;
+			size_t size = value.size();
+			if (size == 0) return candidates;
+
+			//drop ever smaller chunks: everything, halves, quarters, ... single elements
+			for (size_t chunk = size; chunk > 0; chunk /= 2)
+				for (size_t begin = 0; begin + chunk <= size; begin += chunk) {
+					C shorter(value.begin(), value.begin() + begin);
+					shorter.insert(shorter.end(), value.begin() + begin + chunk, value.end());
+					candidates.push_back(std::move(shorter));
+				}
+
+			for (size_t i = 0; i < size; i++)
+				for (const T& simpler : element.mShrink(value[i])) {
+					C changed = value;
+					changed[i] = simpler;
+					candidates.push_back(std::move(changed));
+				}
+			return candidates;
+		}
+
+		/// <summary>
+		/// Vectors of up to maxSize Elements
+		/// </summary>
+		/// <typeparam name="T">the Type of the Elements</typeparam>
+		/// <param name="element">the Generator of the Elements</param>
+		/// <param name="maxSize">the largest Size</param>
+		/// <returns>the Generator</returns>
+		template<typename T>
+		Generator<std::vector<T>> vector(Generator<T> element, size_t maxSize) {
+			Generator<std::vector<T>> generator;
+			generator.mGenerate = [element, maxSize](Random& random) {
+				std::vector<T> value(static_cast<size_t>(below(random, maxSize)));
+				for (size_t i = 0; i < value.size(); i++) value[i] = element.mGenerate(random);
+				return value;
+			};
+			generator.mShrink = [element](const std::vector<T>& value) {
+				return shrinkSequence(value, element);
+			};
+			return generator;
+		}
+
+		/// <summary>
+		/// Strings of up to maxLength Characters of an Alphabet,
+		/// Characters are shrunk towards the first of the Alphabet
+		/// </summary>
+		/// <param name="maxLength">the largest Length</param>
+		/// <param name="alphabet">the Characters to use, printable ASCII by default</param>
+		/// <returns>the Generator</returns>
+		inline Generator<std::string> string(size_t maxLength, std::string alphabet = std::string()) {
+			if (alphabet.empty())
+				for (char c = ' '; c <= '~'; c++) alphabet += c;
+			Generator<char> character = oneOf(std::vector<char>(alphabet.begin(), alphabet.end()));
+
+			Generator<std::string> generator;
+			generator.mGenerate = [character, maxLength](Random& random) {
+				std::string value(static_cast<size_t>(below(random, maxLength)), ' ');
+				for (auto& c : value) c = character.mGenerate(random);
+				return value;
+			};
+			generator.mShrink = [character](const std::string& value) {
+				return shrinkSequence(value, character);
+			};
+			return generator;
+		}
+	}
+
+}
+
+#endif
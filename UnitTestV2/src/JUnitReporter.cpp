@@ -0,0 +1,165 @@
+#include "JUnitReporter.h"
+#include "Testable.h"
+#include <sstream>
+#include <string_view>
+
+namespace Test {
+	namespace {
+		//room for the totals of any run, the header is padded to it
+		constexpr size_t gHeaderWidth = 160;
+
+		/// <summary>
+		/// Writes Text with the XML special Characters escaped
+		/// </summary>
+		/// <param name="stream">the stream to write to</param>
+		/// <param name="text">the Text</param>
+		/// <param name="length">the Length of the Text</param>
+		void escape(std::ostream& stream, const char* text, size_t length) {
+			size_t begin = 0;
+			for (size_t i = 0; i < length; i++) {
+				const char* replacement;
+				switch (text[i]) {
+				case '&': replacement = "&amp;"; break;
+				case '<': replacement = "&lt;"; break;
+				case '>': replacement = "&gt;"; break;
+				case '"': replacement = "&quot;"; break;
+				case '\'': replacement = "&apos;"; break;
+				case '\t': case '\n': case '\r': continue;
+				default:
+					//other control characters are not allowed in XML 1.0, not even escaped
+					if (static_cast<unsigned char>(text[i]) >= 0x20) continue;
+					replacement = "?";
+				}
+				stream.write(text + begin, i - begin) << replacement;
+				begin = i + 1;
+			}
+			stream.write(text + begin, length - begin);
+		}
+
+		void escape(std::ostream& stream, const char* text) {
+			escape(stream, text, std::char_traits<char>::length(text));
+		}
+
+		//also takes std::string, and utString in either of its forms
+		void escape(std::ostream& stream, std::string_view text) {
+			escape(stream, text.data(), text.size());
+		}
+	}
+
+
+	/// <summary>
+	/// Creates a Reporter writing to a File
+	/// </summary>
+	/// <param name="path">the File to write</param>
+	JUnitReporter::JUnitReporter(const std::string& path) : mFile(path) {}
+
+	/// <summary>
+	/// Writes the Header of the Test Suite, padded to a fixed Width
+	/// </summary>
+	/// <param name="duration">the Duration of the Run in Milliseconds</param>
+	void JUnitReporter::writeHeader(double duration) {
+		std::ostringstream header;
+		header << "<testsuite name=\"UnitTest\" tests=\"" << mTests
+			<< "\" failures=\"" << mFailures
+			<< "\" errors=\"" << mErrors
+			<< "\" time=\"" << duration / 1000 << '"';
+
+		//whitespace before the closing bracket is allowed, so the header keeps its size
+		std::string text = header.str();
+		if (text.size() < gHeaderWidth) text.append(gHeaderWidth - text.size(), ' ');
+		mFile << text << ">\n";
+	}
+
+	/// <summary>
+	/// Writes the XML Declaration and a Header with empty Totals
+	/// </summary>
+	/// <param name="tests">the Number of Tests that will run</param>
+	void JUnitReporter::suiteStart(size_t) {
+		mTests = mFailures = mErrors = 0;
+		//a document holds a single suite, a repeated run starts the file over
+		if (mStarted) mFile.rewrite();
+		mStarted = true;
+		mFile << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+		mHeader = mFile.tellp();
+		writeHeader(0);
+	}
+
+	/// <summary>
+	/// Writes the Test Case of a finished Test
+	/// </summary>
+	/// <param name="test">the Test</param>
+	void JUnitReporter::testEnd(const Testable& test) {
+		mTests++;
+		mFile << "\t<testcase classname=\"UnitTest\" name=\"";
+		escape(mFile, test.getName());
+
+		if (test.isAbandoned()) {
+			mErrors++;
+			mFile << "\" time=\"0\">\n"
+				<< "\t\t<error type=\"timeout\" message=\"Abandoned after the global Timeout, still running\"/>\n"
+				<< "\t</testcase>\n";
+			return;
+		}
+
+		const TestResultCollection& results = test.getResults();
+		mFile << "\" time=\"" << test.getTime().count() / 1000 << "\">\n";
+
+		results.forEach([this](const char* code, const SourceLocation& location, const char* values) {
+			mFile << "\t\t<failure type=\"assertion\" message=\"";
+			escape(mFile, code);
+			mFile << "\">";
+			escape(mFile, location.mFile);
+			mFile << ':' << location.mLine;
+			if (values) {
+				mFile << "\nValues: ";
+				escape(mFile, values);
+			}
+			mFile << "</failure>\n";
+		});
+		if (results.omittedCount() > 0)
+			mFile << "\t\t<failure type=\"omitted\" message=\"" << results.omittedCount() << " more Fails past the Limit\"/>\n";
+
+		if (results.hasError()) {
+			mFile << "\t\t<error type=\"" << (results.hasTimedOut() ? "timeout" : "error") << "\" message=\"";
+			escape(mFile, results.getError());
+			mFile << "\"/>\n";
+		}
+
+		if (results.hasError()) mErrors++;
+		else if (results.failCount() > 0) mFailures++;
+
+		//the rerun extension of surefire, CI servers show the test as passed but flaky
+		if (results.isFlaky()) {
+			mFile << "\t\t<flakyFailure type=\"retry\" message=\"";
+			escape(mFile, results.getRetryCause());
+			mFile << "\"/>\n";
+		}
+
+		std::string output = test.getOutput();
+		if (!output.empty()) {
+			mFile << "\t\t<system-out>";
+			escape(mFile, output);
+			mFile << "</system-out>\n";
+		}
+		mFile << "\t</testcase>\n";
+	}
+
+	/// <summary>
+	/// Closes the Document and patches the Totals into the Header
+	/// </summary>
+	/// <param name="summary">the Totals of the Run</param>
+	void JUnitReporter::suiteEnd(const RunSummary& summary) {
+		if (!summary.mRawOutput.empty()) {
+			mFile << "\t<system-out>";
+			escape(mFile, summary.mRawOutput);
+			mFile << "</system-out>\n";
+		}
+		mFile << "</testsuite>\n";
+
+		std::streampos end = mFile.tellp();
+		mFile.seekp(mHeader);
+		writeHeader(summary.mDuration);
+		mFile.seekp(end);
+		mFile.flush();
+	}
+}
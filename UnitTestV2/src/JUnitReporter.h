@@ -0,0 +1,51 @@
+#pragma once
+#ifndef UT_JUNITREPORTER_H
+#define UT_JUNITREPORTER_H
+
+#include <string>
+#include "Reporter.h"
+#include "BufferedFile.h"
+
+namespace Test {
+
+	/// <summary>
+	/// Writes a JUnit XML Report, readable by CI Servers.
+	/// Every Test is written when it finishes, only the Totals in the
+	/// Header are patched in at the End, so the Document is never held in Memory.
+	/// A repeated Run rewrites the File, it holds the last Iteration.
+	/// </summary>
+	class JUnitReporter : public Reporter {
+	private:	//private Members
+		BufferedFile mFile;
+		std::streampos mHeader;
+		bool mStarted = false;
+
+		uint64_t mTests = 0;
+		uint64_t mFailures = 0;
+		uint64_t mErrors = 0;
+
+	public:		//Constructors and Destructors
+		/// <summary>
+		/// Creates a Reporter writing to a File
+		/// </summary>
+		/// <param name="path">the File to write</param>
+		explicit JUnitReporter(const std::string& path);
+
+		JUnitReporter(const JUnitReporter&) = delete;
+
+	private:	//internal functionality
+		/// <summary>
+		/// Writes the Header of the Test Suite, padded to a fixed Width
+		/// </summary>
+		/// <param name="duration">the Duration of the Run in Milliseconds</param>
+		void writeHeader(double duration);
+
+	public:		//Events
+		void suiteStart(size_t tests) override;
+		void testEnd(const Testable& test) override;
+		void suiteEnd(const RunSummary& summary) override;
+	};
+
+}
+
+#endif
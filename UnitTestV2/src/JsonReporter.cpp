@@ -0,0 +1,191 @@
+#include "JsonReporter.h"
+#include "Testable.h"
+#include "TestCollection.h"
+#include <string_view>
+
+namespace Test {
+	namespace {
+		/// <summary>
+		/// Writes Text as a quoted JSON String
+		/// </summary>
+		/// <param name="stream">the stream to write to</param>
+		/// <param name="text">the Text</param>
+		/// <param name="length">the Length of the Text</param>
+		void quote(std::ostream& stream, const char* text, size_t length) {
+			static constexpr char hex[] = "0123456789abcdef";
+
+			stream << '"';
+			size_t begin = 0;
+			for (size_t i = 0; i < length; i++) {
+				unsigned char c = static_cast<unsigned char>(text[i]);
+				if (c >= 0x20 && c != '"' && c != '\\') continue;
+
+				stream.write(text + begin, i - begin);
+				begin = i + 1;
+				switch (c) {
+				case '"': stream << "\\\""; break;
+				case '\\': stream << "\\\\"; break;
+				case '\n': stream << "\\n"; break;
+				case '\r': stream << "\\r"; break;
+				case '\t': stream << "\\t"; break;
+				default: stream << "\\u00" << hex[c >> 4] << hex[c & 0xf];
+				}
+			}
+			stream.write(text + begin, length - begin);
+			stream << '"';
+		}
+
+		void quote(std::ostream& stream, const char* text) {
+			quote(stream, text, std::char_traits<char>::length(text));
+		}
+
+		//also takes std::string, and utString in either of its forms
+		void quote(std::ostream& stream, std::string_view text) {
+			quote(stream, text.data(), text.size());
+		}
+
+		/// <summary>
+		/// returns the Status of a finished Test, as shown in the Report
+		/// </summary>
+		/// <param name="test">the Test</param>
+		/// <returns>the Status</returns>
+		const char* status(const Testable& test) {
+			if (test.isAbandoned()) return "abandoned";
+			if (test.getResults().hasTimedOut()) return "timed out";
+			if (test.hasFailed()) return "failed";
+			if (test.getResults().isFlaky()) return "flaky";
+			if (test.isRegressed()) return "perf-regressed";
+			return "passed";
+		}
+	}
+
+
+	/// <summary>
+	/// Creates a Reporter writing to a File
+	/// </summary>
+	/// <param name="path">the File to write</param>
+	JsonReporter::JsonReporter(const std::string& path) : mFile(path) {}
+
+	/// <summary>
+	/// Writes the "suite" Line
+	/// </summary>
+	/// <param name="tests">the Number of Tests that will run</param>
+	void JsonReporter::suiteStart(size_t tests) {
+		mFile << "{\"type\":\"suite\",\"tests\":" << tests << "}\n";
+	}
+
+	/// <summary>
+	/// Writes the "test" Line of a finished Test
+	/// </summary>
+	/// <param name="test">the Test</param>
+	void JsonReporter::testEnd(const Testable& test) {
+		mFile << "{\"type\":\"test\",\"name\":";
+		quote(mFile, test.getName());
+		mFile << ",\"status\":\"" << status(test) << '"';
+
+		if (test.isAbandoned()) {
+			mFile << "}\n";
+			return;
+		}
+
+		const TestResultCollection& results = test.getResults();
+		mFile << ",\"duration\":" << test.getTime().count();
+		if (results.getAttempts() > 1) {
+			mFile << ",\"attempts\":" << results.getAttempts() << ",\"firstFailure\":";
+			quote(mFile, results.getRetryCause());
+		}
+		mFile << ",\"failures\":[";
+
+		bool first = true;
+		results.forEach([this, &first](const char* code, const SourceLocation& location, const char* values) {
+			mFile << (first ? "" : ",") << "{\"condition\":";
+			quote(mFile, code);
+			mFile << ",\"file\":";
+			quote(mFile, location.mFile);
+			mFile << ",\"line\":" << location.mLine;
+			if (values) {
+				mFile << ",\"values\":";
+				quote(mFile, values);
+			}
+			mFile << '}';
+			first = false;
+		});
+		mFile << ']';
+		if (results.omittedCount() > 0) mFile << ",\"omitted\":" << results.omittedCount();
+
+		if (results.hasError()) {
+			mFile << ",\"error\":";
+			quote(mFile, results.getError());
+		}
+
+		if (test.isRegressed())
+			mFile << ",\"baseline\":" << test.getBaseline()->mMean << ",\"timing\":" << test.getTiming().mMean;
+
+		const PerfCounters::Values& counters = test.getCounters();
+		if (counters.any()) {
+			mFile << ",\"counters\":{";
+			first = true;
+			for (int i = 0; i < PerfCounters::CounterCount; i++) {
+				if (!counters.mValid[i]) continue;
+				mFile << (first ? "\"" : ",\"") << PerfCounters::name(PerfCounters::Counter(i)) << "\":" << counters.mValues[i];
+				first = false;
+			}
+			mFile << '}';
+		}
+
+		if (TestCollection::isAllocationTracking() && AllocationTracker::isEnabled()) {
+			const AllocationTracker::Statistics& allocations = test.getAllocations();
+			mFile << ",\"allocations\":{\"count\":" << allocations.mAllocations
+				<< ",\"bytes\":" << allocations.mBytes
+				<< ",\"peak\":" << allocations.mPeak << '}';
+		}
+
+		std::string output = test.getOutput();
+		if (!output.empty()) {
+			mFile << ",\"output\":";
+			quote(mFile, output);
+		}
+		mFile << "}\n";
+	}
+
+	/// <summary>
+	/// Writes the "summary" Line
+	/// </summary>
+	/// <param name="summary">the Totals of the Run</param>
+	void JsonReporter::suiteEnd(const RunSummary& summary) {
+		mFile << "{\"type\":\"summary\",\"failed\":" << summary.mFailed
+			<< ",\"passed\":" << summary.mPassed
+			<< ",\"duration\":" << summary.mDuration;
+		if (summary.mHasBaseline) mFile << ",\"regressed\":" << summary.mRegressed;
+		if (summary.mFlaky > 0) mFile << ",\"flaky\":" << summary.mFlaky;
+		if (summary.mShardCount > 1)
+			mFile << ",\"shard\":" << summary.mShardIndex << ",\"shards\":" << summary.mShardCount;
+		if (summary.mIteration > 0)
+			mFile << ",\"iteration\":" << summary.mIteration;
+		if (summary.mSeed != 0)
+			mFile << ",\"seed\":" << summary.mSeed;
+		if (summary.mDeselected > 0)
+			mFile << ",\"deselected\":" << summary.mDeselected;
+		if (!summary.mFixtures.empty()) {
+			mFile << ",\"fixtures\":[";
+			for (size_t i = 0; i < summary.mFixtures.size(); i++) {
+				const FixtureSummary& fixture = summary.mFixtures[i];
+				mFile << (i ? "," : "") << "{\"name\":";
+				quote(mFile, fixture.mName);
+				mFile << ",\"tests\":" << fixture.mUsers << ",\"build\":" << fixture.mBuildTime;
+				if (!fixture.mError.empty()) {
+					mFile << ",\"error\":";
+					quote(mFile, fixture.mError);
+				}
+				mFile << '}';
+			}
+			mFile << ']';
+		}
+		if (!summary.mRawOutput.empty()) {
+			mFile << ",\"output\":";
+			quote(mFile, summary.mRawOutput);
+		}
+		mFile << "}\n";
+		mFile.flush();
+	}
+}
@@ -0,0 +1,36 @@
+#pragma once
+#ifndef UT_JSONREPORTER_H
+#define UT_JSONREPORTER_H
+
+#include <string>
+#include "Reporter.h"
+#include "BufferedFile.h"
+
+namespace Test {
+
+	/// <summary>
+	/// Writes a JSON Lines Report: one Object per Line, a "suite" Line at the
+	/// Start, a "test" Line for every finished Test and a "summary" Line at the End.
+	/// </summary>
+	class JsonReporter : public Reporter {
+	private:	//private Members
+		BufferedFile mFile;
+
+	public:		//Constructors and Destructors
+		/// <summary>
+		/// Creates a Reporter writing to a File
+		/// </summary>
+		/// <param name="path">the File to write</param>
+		explicit JsonReporter(const std::string& path);
+
+		JsonReporter(const JsonReporter&) = delete;
+
+	public:		//Events
+		void suiteStart(size_t tests) override;
+		void testEnd(const Testable& test) override;
+		void suiteEnd(const RunSummary& summary) override;
+	};
+
+}
+
+#endif
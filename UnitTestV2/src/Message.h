@@ -0,0 +1,109 @@
+#pragma once
+#ifndef UT_MESSAGE_H
+#define UT_MESSAGE_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace Test {
+
+	/// <summary>
+	/// Builds a binary Message from trivially copyable Values and Strings.
+	/// Messages are only exchanged between Processes forked from the same
+	/// Binary, so Layout and Byte Order always match.
+	/// </summary>
+	class MessageWriter {
+	private:	//private Members
+		std::string mBuffer;
+
+	public:		//exposed Functionality
+		/// <summary>
+		/// Appends the Bytes of a Value
+		/// </summary>
+		/// <param name="value">the Value to append</param>
+		template<typename T>
+		void write(const T& value) {
+			static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable values can be written");
+			mBuffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+		}
+
+		/// <summary>
+		/// Appends a String with its Length
+		/// </summary>
+		/// <param name="text">the String to append</param>
+		void writeString(const std::string& text) {
+			write<uint64_t>(text.size());
+			mBuffer.append(text);
+		}
+
+		/// <summary>
+		/// returns the Message built so far
+		/// </summary>
+		/// <returns>the Bytes of the Message</returns>
+		const std::string& buffer() const {
+			return mBuffer;
+		}
+	};
+
+	/// <summary>
+	/// Reads the Values of a Message in the Order they were written
+	/// </summary>
+	class MessageReader {
+	private:	//private Members
+		const char* mPosition;
+		const char* mEnd;
+
+	public:		//Constructors and Destructors
+		/// <summary>
+		/// Creates a Reader over the Bytes of a Message
+		/// </summary>
+		/// <param name="data">the first Byte</param>
+		/// <param name="size">the Number of Bytes</param>
+		MessageReader(const char* data, size_t size) : mPosition(data), mEnd(data + size) {}
+
+	public:		//exposed Functionality
+		/// <summary>
+		/// Reads the Bytes of a Value
+		/// </summary>
+		/// <param name="value">receives the Value</param>
+		/// <returns>false when the Message is too short</returns>
+		template<typename T>
+		bool read(T& value) {
+			static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable values can be read");
+			if (static_cast<size_t>(mEnd - mPosition) < sizeof(T)) return false;
+			std::memcpy(&value, mPosition, sizeof(T));
+			mPosition += sizeof(T);
+			return true;
+		}
+
+		/// <summary>
+		/// Reads a Flag, the Byte is checked instead of copied into the bool
+		/// </summary>
+		/// <param name="value">receives the Flag</param>
+		/// <returns>false when the Message is too short or the Byte is not a bool</returns>
+		bool read(bool& value) {
+			uint8_t byte;
+			if (!read(byte) || byte > 1) return false;
+			value = byte != 0;
+			return true;
+		}
+
+		/// <summary>
+		/// Reads a String written with writeString
+		/// </summary>
+		/// <param name="text">receives the String</param>
+		/// <returns>false when the Message is too short</returns>
+		bool readString(std::string& text) {
+			uint64_t size;
+			if (!read(size) || static_cast<uint64_t>(mEnd - mPosition) < size) return false;
+			text.assign(mPosition, static_cast<size_t>(size));
+			mPosition += size;
+			return true;
+		}
+	};
+
+}
+
+#endif
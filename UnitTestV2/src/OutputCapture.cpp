@@ -0,0 +1,264 @@
+#include "OutputCapture.h"
+#include <cerrno>
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+namespace Test {
+	thread_local std::streambuf* OutputCapture::tOut = nullptr;
+	thread_local std::streambuf* OutputCapture::tIn = nullptr;
+
+	namespace {
+		/// <summary>
+		/// State of the File Descriptor Capture, only touched by begin/endFileCapture
+		/// </summary>
+		struct FileCapture {
+			int savedFd = -1;
+			int readFd = -1;
+			std::thread reader;
+			std::string output;
+		};
+
+		FileCapture gFileCapture;
+
+		//guards the saved descriptor against the console buffer writing to it
+		std::mutex gConsoleMutex;
+	}
+
+
+	/// <summary>
+	/// Creates the Output Redirect
+	/// </summary>
+	/// <param name="fallback">the Buffer used by Threads without a Target</param>
+	OutputCapture::OutputRedirect::OutputRedirect(std::streambuf* fallback) : mFallback(fallback) {}
+
+	/// <summary>
+	/// returns the Buffer the calling Thread writes to
+	/// </summary>
+	std::streambuf* OutputCapture::OutputRedirect::target() const {
+		return tOut ? tOut : mFallback;
+	}
+
+	OutputCapture::OutputRedirect::int_type OutputCapture::OutputRedirect::overflow(int_type c) {
+		if (traits_type::eq_int_type(c, traits_type::eof())) return traits_type::not_eof(c);
+		return target()->sputc(traits_type::to_char_type(c));
+	}
+
+	std::streamsize OutputCapture::OutputRedirect::xsputn(const char_type* s, std::streamsize count) {
+		return target()->sputn(s, count);
+	}
+
+	int OutputCapture::OutputRedirect::sync() {
+		return target()->pubsync();
+	}
+
+
+	/// <summary>
+	/// Creates the Input Redirect
+	/// </summary>
+	/// <param name="fallback">the Buffer used by Threads without a Source</param>
+	OutputCapture::InputRedirect::InputRedirect(std::streambuf* fallback) : mFallback(fallback) {}
+
+	/// <summary>
+	/// returns the Buffer the calling Thread reads from
+	/// </summary>
+	std::streambuf* OutputCapture::InputRedirect::source() const {
+		return tIn ? tIn : mFallback;
+	}
+
+	OutputCapture::InputRedirect::int_type OutputCapture::InputRedirect::underflow() {
+		return source()->sgetc();
+	}
+
+	OutputCapture::InputRedirect::int_type OutputCapture::InputRedirect::uflow() {
+		return source()->sbumpc();
+	}
+
+	OutputCapture::InputRedirect::int_type OutputCapture::InputRedirect::pbackfail(int_type c) {
+		if (traits_type::eq_int_type(c, traits_type::eof())) return source()->sungetc();
+		return source()->sputbackc(traits_type::to_char_type(c));
+	}
+
+	std::streamsize OutputCapture::InputRedirect::xsgetn(char_type* s, std::streamsize count) {
+		return source()->sgetn(s, count);
+	}
+
+	std::streamsize OutputCapture::InputRedirect::showmanyc() {
+		return source()->in_avail();
+	}
+
+
+	/// <summary>
+	/// Creates the Console Buffer
+	/// </summary>
+	/// <param name="fallback">the original Buffer of std::cout</param>
+	OutputCapture::ConsoleBuffer::ConsoleBuffer(std::streambuf* fallback) : mFallback(fallback) {
+		setp(mBuffer, mBuffer + sizeof(mBuffer));
+	}
+
+	/// <summary>
+	/// Writes the buffered Output to the Console
+	/// </summary>
+	/// <returns>false when the Output could not be written</returns>
+	bool OutputCapture::ConsoleBuffer::drain() {
+		std::streamsize count = pptr() - pbase();
+		setp(mBuffer, mBuffer + sizeof(mBuffer));
+
+		std::lock_guard<std::mutex> lock(gConsoleMutex);
+#if !defined(_WIN32)
+		if (gFileCapture.savedFd >= 0) {
+			for (const char* data = mBuffer; count > 0;) {
+				ssize_t written = ::write(gFileCapture.savedFd, data, static_cast<size_t>(count));
+				if (written < 0 && errno == EINTR) continue;
+				if (written <= 0) return false;
+				data += written;
+				count -= written;
+			}
+			return true;
+		}
+#endif
+		return mFallback->sputn(mBuffer, count) == count && mFallback->pubsync() == 0;
+	}
+
+	OutputCapture::ConsoleBuffer::int_type OutputCapture::ConsoleBuffer::overflow(int_type c) {
+		if (!drain()) return traits_type::eof();
+		if (traits_type::eq_int_type(c, traits_type::eof())) return traits_type::not_eof(c);
+		return sputc(traits_type::to_char_type(c));
+	}
+
+	int OutputCapture::ConsoleBuffer::sync() {
+		return drain() ? 0 : -1;
+	}
+
+
+	/// <summary>
+	/// Swaps the forwarding Buffers into std::cout and std::cin
+	/// </summary>
+	OutputCapture::Installation::Installation()
+		: mCoutBackup(std::cout.rdbuf()), mCinBackup(std::cin.rdbuf()),
+		mOut(mCoutBackup), mIn(mCinBackup), mConsole(mCoutBackup) {
+		std::cout.rdbuf(&mOut);
+		std::cin.rdbuf(&mIn);
+	}
+
+	/// <summary>
+	/// Puts the original Buffers back before the forwarding ones are destroyed
+	/// </summary>
+	OutputCapture::Installation::~Installation() {
+		std::cout.rdbuf(mCoutBackup);
+		std::cin.rdbuf(mCinBackup);
+	}
+
+
+	/// <summary>
+	/// Replaces the Buffers of std::cout and std::cin with the forwarding ones.
+	/// Only the first Call has an Effect.
+	/// </summary>
+	void OutputCapture::install() {
+		installation();
+	}
+
+	/// <summary>
+	/// returns the Installation, created on first Use
+	/// </summary>
+	OutputCapture::Installation& OutputCapture::installation() {
+		static Installation installation;
+		return installation;
+	}
+
+	/// <summary>
+	/// Returns a Buffer writing to the Console, which bypasses the File Descriptor Capture
+	/// </summary>
+	/// <returns>the Buffer</returns>
+	std::streambuf* OutputCapture::console() {
+		return &installation().mConsole;
+	}
+
+	/// <summary>
+	/// Redirects std::cout and std::cin of the calling Thread
+	/// </summary>
+	/// <param name="out">receives everything written to std::cout</param>
+	/// <param name="in">provides everything read from std::cin</param>
+	void OutputCapture::attach(std::streambuf* out, std::streambuf* in) {
+		install();
+		tOut = out;
+		tIn = in;
+	}
+
+	/// <summary>
+	/// Sends std::cout and std::cin of the calling Thread back to the original Buffers
+	/// </summary>
+	void OutputCapture::detach() {
+		tOut = nullptr;
+		tIn = nullptr;
+	}
+
+	/// <summary>
+	/// Starts capturing everything written to the stdout File Descriptor
+	/// (printf, write(1, ...)) through a Pipe drained by a Reader Thread.
+	/// </summary>
+	/// <returns>false when not supported or the Pipe could not be created</returns>
+	bool OutputCapture::beginFileCapture() {
+#if defined(_WIN32)
+		return false;
+#else
+		if (gFileCapture.savedFd >= 0) return true;
+
+		int fds[2];
+		if (pipe(fds) != 0) return false;
+
+		std::fflush(stdout);
+		std::lock_guard<std::mutex> lock(gConsoleMutex);
+		gFileCapture.savedFd = dup(STDOUT_FILENO);
+		if (gFileCapture.savedFd < 0 || dup2(fds[1], STDOUT_FILENO) < 0) {
+			if (gFileCapture.savedFd >= 0) close(gFileCapture.savedFd);
+			gFileCapture.savedFd = -1;
+			close(fds[0]);
+			close(fds[1]);
+			return false;
+		}
+		close(fds[1]);
+
+		gFileCapture.readFd = fds[0];
+		gFileCapture.output.clear();
+		gFileCapture.reader = std::thread([]()->void {
+			char buffer[4096];
+			ssize_t count;
+			while ((count = read(gFileCapture.readFd, buffer, sizeof(buffer))) != 0) {
+				if (count > 0) gFileCapture.output.append(buffer, static_cast<size_t>(count));
+				else if (errno != EINTR) break;
+			}
+		});
+		return true;
+#endif
+	}
+
+	/// <summary>
+	/// Restores the stdout File Descriptor and collects the captured Output
+	/// </summary>
+	/// <returns>everything written to the File Descriptor since beginFileCapture</returns>
+	std::string OutputCapture::endFileCapture() {
+#if !defined(_WIN32)
+		if (gFileCapture.savedFd < 0) return "";
+
+		//restoring the descriptor closes the last write end, so the reader sees EOF
+		std::fflush(stdout);
+		{
+			std::lock_guard<std::mutex> lock(gConsoleMutex);
+			dup2(gFileCapture.savedFd, STDOUT_FILENO);
+			close(gFileCapture.savedFd);
+			gFileCapture.savedFd = -1;
+		}
+
+		gFileCapture.reader.join();
+		close(gFileCapture.readFd);
+		gFileCapture.readFd = -1;
+#endif
+		return std::move(gFileCapture.output);
+	}
+}
@@ -0,0 +1,152 @@
+#pragma once
+#ifndef UT_OUTPUT_CAPTURE_H
+#define UT_OUTPUT_CAPTURE_H
+
+#include <streambuf>
+#include <string>
+
+namespace Test {
+
+	/// <summary>
+	/// Redirects std::cout and std::cin per Thread.
+	/// The global Stream Buffers are replaced once with forwarding Buffers,
+	/// which pass every Read and Write on to the Buffers attached to the
+	/// calling Thread, or to the original Buffers if none are attached.
+	/// Only the Buffers are per Thread, the Stream State (eof, fail) of
+	/// std::cin is still shared by all Threads.
+	/// </summary>
+	class OutputCapture {
+	private:	//internal Classes
+		/// <summary>
+		/// unbuffered Output Buffer forwarding to the Threads Target
+		/// </summary>
+		class OutputRedirect : public std::streambuf {
+		private:	//private Members
+			std::streambuf* mFallback;
+
+		public:		//Constructors and Destructors
+			explicit OutputRedirect(std::streambuf* fallback);
+
+		private:	//internal Functionality
+			std::streambuf* target() const;
+
+		protected:	//streambuf overrides
+			int_type overflow(int_type c) override;
+			std::streamsize xsputn(const char_type* s, std::streamsize count) override;
+			int sync() override;
+		};
+
+		/// <summary>
+		/// unbuffered Input Buffer forwarding to the Threads Source
+		/// </summary>
+		class InputRedirect : public std::streambuf {
+		private:	//private Members
+			std::streambuf* mFallback;
+
+		public:		//Constructors and Destructors
+			explicit InputRedirect(std::streambuf* fallback);
+
+		private:	//internal Functionality
+			std::streambuf* source() const;
+
+		protected:	//streambuf overrides
+			int_type underflow() override;
+			int_type uflow() override;
+			int_type pbackfail(int_type c) override;
+			std::streamsize xsgetn(char_type* s, std::streamsize count) override;
+			std::streamsize showmanyc() override;
+		};
+
+		/// <summary>
+		/// buffered Output Buffer writing to the Console: to the saved stdout
+		/// File Descriptor while it is captured, else to the original Buffer
+		/// </summary>
+		class ConsoleBuffer : public std::streambuf {
+		private:	//private Members
+			std::streambuf* mFallback;
+			char mBuffer[4096];
+
+		public:		//Constructors and Destructors
+			explicit ConsoleBuffer(std::streambuf* fallback);
+
+		private:	//internal Functionality
+			bool drain();
+
+		protected:	//streambuf overrides
+			int_type overflow(int_type c) override;
+			int sync() override;
+		};
+
+		/// <summary>
+		/// Owns the forwarding Buffers and puts the original ones back on Exit
+		/// </summary>
+		class Installation {
+			friend OutputCapture;
+		private:	//private Members
+			std::streambuf* mCoutBackup;
+			std::streambuf* mCinBackup;
+			OutputRedirect mOut;
+			InputRedirect mIn;
+			ConsoleBuffer mConsole;
+
+		public:		//Constructors and Destructors
+			Installation();
+			~Installation();
+		};
+
+	private:	//private Members
+		static thread_local std::streambuf* tOut;
+		static thread_local std::streambuf* tIn;
+
+	private:	//internal Functionality
+		/// <summary>
+		/// returns the Installation, created on first Use
+		/// </summary>
+		static Installation& installation();
+
+	public:		//exposed Functionality
+		/// <summary>
+		/// Replaces the Buffers of std::cout and std::cin with the forwarding ones.
+		/// Only the first Call has an Effect.
+		/// </summary>
+		static void install();
+
+		/// <summary>
+		/// Redirects std::cout and std::cin of the calling Thread
+		/// </summary>
+		/// <param name="out">receives everything written to std::cout</param>
+		/// <param name="in">provides everything read from std::cin</param>
+		static void attach(std::streambuf* out, std::streambuf* in);
+
+		/// <summary>
+		/// Sends std::cout and std::cin of the calling Thread back to the original Buffers
+		/// </summary>
+		static void detach();
+
+		/// <summary>
+		/// Starts capturing everything written to the stdout File Descriptor
+		/// (printf, write(1, ...)) through a Pipe drained by a Reader Thread.
+		/// The File Descriptor is shared by the whole Process, so this Output
+		/// can't be attributed to a single Test.
+		/// </summary>
+		/// <returns>false when not supported or the Pipe could not be created</returns>
+		static bool beginFileCapture();
+
+		/// <summary>
+		/// Restores the stdout File Descriptor and collects the captured Output
+		/// </summary>
+		/// <returns>everything written to the File Descriptor since beginFileCapture</returns>
+		static std::string endFileCapture();
+
+		/// <summary>
+		/// Returns a Buffer writing to the Console, which bypasses the File Descriptor
+		/// Capture. The Writer Thread of the Reporters attaches it, so Reports to
+		/// std::cout stream live instead of ending up in the captured Output.
+		/// </summary>
+		/// <returns>the Buffer</returns>
+		static std::streambuf* console();
+	};
+
+}
+
+#endif
@@ -0,0 +1,233 @@
+#pragma once
+#ifndef UT_PARAMETERIZED_TESTABLE_H
+#define UT_PARAMETERIZED_TESTABLE_H
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iomanip>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Testable.h"
+
+namespace Test {
+
+	template<typename Case>
+	class Parameterized;
+
+	/// <summary>
+	/// A Test run once for every Parameter of a Table. Subclasses implement
+	/// runCase instead of run and are instantiated by Parameterized, once for
+	/// every Batch of Parameters. Every Batch is a Test of its own, so the
+	/// Batches run in parallel on the Workers and are reported separately.
+	/// </summary>
+	/// <typeparam name="Param">the Type of a Parameter</typeparam>
+	template<typename Param>
+	class ParameterizedTestable : public Testable {
+		template<typename> friend class Parameterized;
+	public:		//definitions
+		typedef Param param_type;
+		typedef std::function<Param(size_t)> source;
+
+	private:	//private Members
+		const source* mSource = nullptr;
+		size_t mBegin = 0;
+		size_t mEnd = 0;
+		size_t mIndex = 0;
+
+		uint64_t mFailedCases = 0;
+		size_t mFirstFailed = 0;
+
+	public:		//Constructors and Destructors
+		/// <summary>
+		/// Creates the Test, Name and Parameters are set by Parameterized
+		/// </summary>
+		ParameterizedTestable() : Testable(std::string()) {}
+
+	private:	//internal functionality
+		/// <summary>
+		/// Sets the Name and the Parameters of the Batch
+		/// </summary>
+		/// <param name="name">the Name of the Batch</param>
+		/// <param name="parameters">returns the Parameter with a given Index</param>
+		/// <param name="begin">the Index of the first Parameter</param>
+		/// <param name="end">the Index after the last Parameter</param>
+		void setup(const std::string& name, const source& parameters, size_t begin, size_t end) {
+			mName = name;
+			mSource = &parameters;
+			mBegin = begin;
+			mEnd = end;
+		}
+
+		/// <summary>
+		/// Counts a Case in which a Check failed
+		/// </summary>
+		void caseFailed() {
+			if (mFailedCases++ == 0) mFirstFailed = mIndex;
+		}
+
+	protected:	//protected functionality (to get overrides from childclasses)
+		/// <summary>
+		/// Runs the Test for a single Parameter
+		/// </summary>
+		/// <param name="param">the Parameter</param>
+		virtual void runCase(const Param& param) = 0;
+
+		/// <summary>
+		/// Runs every Case of the Batch, until the Test is asked to stop
+		/// </summary>
+		void run() final {
+			for (mIndex = mBegin; mIndex < mEnd && !shouldStop(); mIndex++) {
+				uint64_t before = getResults().failCount();
+				try {
+					runCase((*mSource)(mIndex));
+				} catch (...) {
+					caseFailed();
+					throw;
+				}
+				if (getResults().failCount() > before) caseFailed();
+			}
+		}
+
+		/// <summary>
+		/// Writes which Cases failed to the Report
+		/// </summary>
+		/// <param name="stream">the stream to write to</param>
+		/// <param name="indent">the Width of the Labels</param>
+		void reportDetails(std::ostream& stream, uint32_t indent) const override {
+			if (mFailedCases == 0) return;
+			stream << std::setw(indent) << std::left << "Failed Cases: "
+				<< mFailedCases << " of " << mEnd - mBegin << ", first #" << mFirstFailed << '\n';
+		}
+
+		/// <summary>
+		/// Writes the Outcome and the failed Cases to a Message
+		/// </summary>
+		/// <param name="writer">the Message to write to</param>
+		void saveState(MessageWriter& writer) const override {
+			Testable::saveState(writer);
+			writer.write(mFailedCases);
+			writer.write(mFirstFailed);
+		}
+
+		/// <summary>
+		/// Reads the Outcome and the failed Cases from a Message
+		/// </summary>
+		/// <param name="reader">the Message to read from</param>
+		/// <returns>false when the Message is malformed</returns>
+		bool loadState(MessageReader& reader) override {
+			return Testable::loadState(reader) && reader.read(mFailedCases) && reader.read(mFirstFailed);
+		}
+
+		/// <summary>
+		/// Forgets the failed Cases of the last Run
+		/// </summary>
+		void reset() override {
+			Testable::reset();
+			mFailedCases = 0;
+			mFirstFailed = 0;
+		}
+
+		/// <summary>
+		/// Returns the Index of the Parameter being tested
+		/// </summary>
+		/// <returns>the Index in the Table</returns>
+		size_t getIndex() const {
+			return mIndex;
+		}
+	};
+
+	/// <summary>
+	/// A Table of Parameters, registered as one Test per Batch of Parameters.
+	/// Must outlive TestCollection::runTests, like any other Test.
+	/// </summary>
+	/// <typeparam name="Case">a default constructible Subclass of ParameterizedTestable</typeparam>
+	template<typename Case>
+	class Parameterized {
+	public:		//definitions
+		typedef typename Case::param_type param_type;
+		typedef typename Case::source source;
+
+	private:	//private Members
+		source mSource;
+		std::vector<std::unique_ptr<Case>> mCases;
+
+	public:		//Constructors and Destructors
+		/// <summary>
+		/// Creates the Tests for Parameters produced on Demand. The Generator is
+		/// called on the Worker running the Case, from many Threads at once.
+		/// </summary>
+		/// <param name="name">the Name of the Table</param>
+		/// <param name="count">the Number of Parameters</param>
+		/// <param name="generator">returns the Parameter with a given Index</param>
+		/// <param name="batch">the Number of Parameters tested by one Test</param>
+		Parameterized(const std::string& name, size_t count, source generator, size_t batch = 1)
+			: mSource(std::move(generator)) {
+			if (batch == 0) batch = 1;
+			mCases.reserve((count + batch - 1) / batch);
+
+			for (size_t begin = 0; begin < count; begin += batch) {
+				size_t end = std::min(begin + batch, count);
+				std::string label = name + '[' + std::to_string(begin);
+				if (end - begin > 1) label += '-' + std::to_string(end - 1);
+
+				mCases.emplace_back(new Case());
+				mCases.back()->setup(label + ']', mSource, begin, end);
+			}
+		}
+
+		/// <summary>
+		/// Creates the Tests for the Parameters of a Range, which are copied
+		/// </summary>
+		/// <param name="name">the Name of the Table</param>
+		/// <param name="parameters">the Parameters</param>
+		/// <param name="batch">the Number of Parameters tested by one Test</param>
+		template<typename Range>
+		Parameterized(const std::string& name, const Range& parameters, size_t batch = 1)
+			: Parameterized(name, std::make_shared<const std::vector<param_type>>(std::begin(parameters), std::end(parameters)), batch) {}
+
+		/// <summary>
+		/// Creates the Tests for a List of Parameters
+		/// </summary>
+		/// <param name="name">the Name of the Table</param>
+		/// <param name="parameters">the Parameters</param>
+		/// <param name="batch">the Number of Parameters tested by one Test</param>
+		Parameterized(const std::string& name, std::initializer_list<param_type> parameters, size_t batch = 1)
+			: Parameterized(name, std::make_shared<const std::vector<param_type>>(parameters), batch) {}
+
+		Parameterized(const Parameterized&) = delete;
+
+	private:	//internal functionality
+		/// <summary>
+		/// Creates the Tests for a Table owned by the Generator
+		/// </summary>
+		/// <param name="name">the Name of the Table</param>
+		/// <param name="table">the Parameters</param>
+		/// <param name="batch">the Number of Parameters tested by one Test</param>
+		Parameterized(const std::string& name, std::shared_ptr<const std::vector<param_type>> table, size_t batch)
+			: Parameterized(name, table->size(), [table](size_t index) { return (*table)[index]; }, batch) {}
+
+	public:		//getters and setters
+		/// <summary>
+		/// Returns the Number of Tests the Parameters were split into
+		/// </summary>
+		/// <returns>the Number of Tests</returns>
+		size_t size() const {
+			return mCases.size();
+		}
+
+		/// <summary>
+		/// Returns one of the Tests, to set its Timeout or Fail Limit
+		/// </summary>
+		/// <param name="index">the Index of the Test</param>
+		/// <returns>the Test</returns>
+		Case& operator[](size_t index) {
+			return *mCases[index];
+		}
+	};
+
+}
+
+#endif
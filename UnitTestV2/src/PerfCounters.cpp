@@ -0,0 +1,152 @@
+#include "PerfCounters.h"
+
+#if defined(__linux__)
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace Test {
+
+#if defined(__linux__)
+	namespace {
+		/// <summary>
+		/// perf_event_open Type and Config of every Counter, in Order of PerfCounters::Counter
+		/// </summary>
+		constexpr struct { uint32_t type; uint64_t config; } gEvents[PerfCounters::CounterCount] = {
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+			{ PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES },
+		};
+
+		/// <summary>
+		/// Opens a single Counter for the calling Thread, disabled
+		/// </summary>
+		int openEvent(uint32_t type, uint64_t config, bool excludeKernel) {
+			perf_event_attr attr;
+			std::memset(&attr, 0, sizeof(attr));
+			attr.size = sizeof(attr);
+			attr.type = type;
+			attr.config = config;
+			attr.disabled = 1;
+			attr.inherit = 1;
+			attr.exclude_kernel = excludeKernel ? 1 : 0;
+			attr.exclude_hv = 1;
+			attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+			return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+		}
+	}
+#endif
+
+
+	/// <summary>
+	/// returns weather any Counter could be read
+	/// </summary>
+	/// <returns>true when at least one Value is valid</returns>
+	bool PerfCounters::Values::any() const {
+		for (bool valid : mValid)
+			if (valid) return true;
+		return false;
+	}
+
+
+	/// <summary>
+	/// Creates the Counters without opening them
+	/// </summary>
+	PerfCounters::PerfCounters() {
+		for (int& fd : mFds) fd = -1;
+	}
+
+	/// <summary>
+	/// Closes all open Counters
+	/// </summary>
+	PerfCounters::~PerfCounters() {
+		close();
+	}
+
+	/// <summary>
+	/// Closes all open Counters
+	/// </summary>
+	void PerfCounters::close() {
+#if defined(__linux__)
+		for (int& fd : mFds) {
+			if (fd >= 0) ::close(fd);
+			fd = -1;
+		}
+#endif
+	}
+
+	/// <summary>
+	/// Opens, resets and enables the Counters for the calling Thread
+	/// </summary>
+	/// <returns>false when no Counter could be opened</returns>
+	bool PerfCounters::start() {
+#if defined(__linux__)
+		close();
+
+		bool opened = false;
+		for (int i = 0; i < CounterCount; i++) {
+			//counting kernel time needs privileges under the usual perf_event_paranoid settings
+			mFds[i] = openEvent(gEvents[i].type, gEvents[i].config, false);
+			if (mFds[i] < 0) mFds[i] = openEvent(gEvents[i].type, gEvents[i].config, true);
+			if (mFds[i] >= 0) opened = true;
+		}
+
+		for (int fd : mFds) {
+			if (fd < 0) continue;
+			ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+			ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+		}
+		return opened;
+#else
+		return false;
+#endif
+	}
+
+	/// <summary>
+	/// Disables the Counters and reads them
+	/// </summary>
+	/// <returns>the counted Values</returns>
+	PerfCounters::Values PerfCounters::stop() {
+		Values values;
+#if defined(__linux__)
+		for (int fd : mFds)
+			if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+
+		for (int i = 0; i < CounterCount; i++) {
+			if (mFds[i] < 0) continue;
+
+			//value, time enabled, time running
+			uint64_t data[3];
+			if (read(mFds[i], data, sizeof(data)) != sizeof(data) || data[2] == 0) continue;
+
+			double scale = static_cast<double>(data[1]) / static_cast<double>(data[2]);
+			values.mValues[i] = static_cast<uint64_t>(static_cast<double>(data[0]) * scale);
+			values.mValid[i] = true;
+		}
+		close();
+#endif
+		return values;
+	}
+
+	/// <summary>
+	/// returns the human readable Name of a Counter
+	/// </summary>
+	/// <param name="counter">the Counter</param>
+	/// <returns>the Name</returns>
+	const char* PerfCounters::name(Counter counter) {
+		switch (counter) {
+		case Cycles:			return "cycles";
+		case Instructions:		return "instructions";
+		case CacheMisses:		return "cache-misses";
+		case BranchMisses:		return "branch-misses";
+		case ContextSwitches:	return "context-switches";
+		default:				return "unknown";
+		}
+	}
+}
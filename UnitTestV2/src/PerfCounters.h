@@ -0,0 +1,85 @@
+#pragma once
+#ifndef UT_PERF_COUNTERS_H
+#define UT_PERF_COUNTERS_H
+
+#include <cstdint>
+
+namespace Test {
+
+	/// <summary>
+	/// Hardware and Software Performance Counters of the calling Thread
+	/// (and Threads it starts), read through perf_event_open on Linux.
+	/// Counters that can't be opened are marked invalid, on other
+	/// Platforms all of them are.
+	/// </summary>
+	class PerfCounters {
+	public:		//exposed Defines
+		enum Counter {
+			Cycles,
+			Instructions,
+			CacheMisses,
+			BranchMisses,
+			ContextSwitches,
+			CounterCount
+		};
+
+		/// <summary>
+		/// Counted Values, scaled up if the Kernel had to multiplex the Counters
+		/// </summary>
+		struct Values {
+			uint64_t mValues[CounterCount] = {};
+			bool mValid[CounterCount] = {};
+
+			/// <summary>
+			/// returns weather any Counter could be read
+			/// </summary>
+			/// <returns>true when at least one Value is valid</returns>
+			bool any() const;
+		};
+
+	private:	//private Members
+		int mFds[CounterCount];
+
+	public:		//Constructors and Destructors
+		/// <summary>
+		/// Creates the Counters without opening them
+		/// </summary>
+		PerfCounters();
+
+		PerfCounters(const PerfCounters&) = delete;
+
+		/// <summary>
+		/// Closes all open Counters
+		/// </summary>
+		~PerfCounters();
+
+	private:	//internal Functionality
+		/// <summary>
+		/// Closes all open Counters
+		/// </summary>
+		void close();
+
+	public:		//exposed Functionality
+		/// <summary>
+		/// Opens, resets and enables the Counters for the calling Thread
+		/// </summary>
+		/// <returns>false when no Counter could be opened</returns>
+		bool start();
+
+		/// <summary>
+		/// Disables the Counters and reads them
+		/// </summary>
+		/// <returns>the counted Values</returns>
+		Values stop();
+
+		/// <summary>
+		/// returns the human readable Name of a Counter
+		/// </summary>
+		/// <param name="counter">the Counter</param>
+		/// <returns>the Name</returns>
+		static const char* name(Counter counter);
+	};
+
+}
+
+#endif
@@ -0,0 +1,421 @@
+#include "ProcessRunner.h"
+#include "TestCollection.h"
+#include "ReportQueue.h"
+#include "Fixture.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+#if !defined(_WIN32)
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace Test {
+
+#if !defined(_WIN32)
+	namespace {
+		/// <summary>
+		/// Size of the Header in front of every Result: Test Index and Payload Size
+		/// </summary>
+		constexpr size_t gHeaderSize = 2 * sizeof(uint64_t);
+
+		/// <summary>
+		/// Largest Payload accepted from a Worker, anything above comes from corrupted Memory
+		/// </summary>
+		constexpr uint64_t gMaxPayload = uint64_t(1) << 28;
+
+		/// <summary>
+		/// Writes the whole Buffer, retrying on partial Writes
+		/// </summary>
+		bool writeAll(int fd, const void* data, size_t size) {
+			const char* position = static_cast<const char*>(data);
+			while (size > 0) {
+				ssize_t written = write(fd, position, size);
+				if (written < 0 && errno == EINTR) continue;
+				if (written <= 0) return false;
+				position += written;
+				size -= static_cast<size_t>(written);
+			}
+			return true;
+		}
+
+		/// <summary>
+		/// Reads exactly the given Number of Bytes
+		/// </summary>
+		bool readAll(int fd, void* data, size_t size) {
+			char* position = static_cast<char*>(data);
+			while (size > 0) {
+				ssize_t count = read(fd, position, size);
+				if (count < 0 && errno == EINTR) continue;
+				if (count <= 0) return false;
+				position += count;
+				size -= static_cast<size_t>(count);
+			}
+			return true;
+		}
+	}
+#endif
+
+
+	/// <summary>
+	/// Creates the Runner for the given Tests
+	/// </summary>
+	/// <param name="tests">the Tests, Indices into this List are sent to the Workers</param>
+	ProcessRunner::ProcessRunner(const std::vector<Testable*>& tests) : mTests(tests) {}
+
+	/// <summary>
+	/// Stops all remaining Workers
+	/// </summary>
+	ProcessRunner::~ProcessRunner() {
+#if !defined(_WIN32)
+		for (auto& worker : mWorkers) {
+			if (worker.mPid < 0) continue;
+			if (worker.mCurrent >= 0) kill(worker.mPid, SIGKILL);
+			stop(worker);
+		}
+#endif
+	}
+
+#if !defined(_WIN32)
+	/// <summary>
+	/// Forks a new Worker into the given Slot
+	/// </summary>
+	/// <param name="worker">the Slot of the Worker</param>
+	/// <returns>false when the Fork failed</returns>
+	bool ProcessRunner::spawn(Worker& worker) {
+		int command[2], result[2];
+		if (pipe(command) != 0) return false;
+		if (pipe(result) != 0) {
+			close(command[0]);
+			close(command[1]);
+			return false;
+		}
+
+		//anything still buffered would otherwise be written by both processes
+		std::fflush(nullptr);
+		std::cout.flush();
+
+		pid_t pid = fork();
+		if (pid < 0) {
+			close(command[0]);
+			close(command[1]);
+			close(result[0]);
+			close(result[1]);
+			return false;
+		}
+
+		if (pid == 0) {
+			//the writer thread was not forked, the parent reports for the worker
+			ReportQueue::disable();
+			close(command[1]);
+			close(result[0]);
+			//holding the other workers pipes open would hide their deaths from the parent
+			for (auto& other : mWorkers) {
+				if (other.mCommand >= 0) close(other.mCommand);
+				if (other.mResult >= 0) close(other.mResult);
+			}
+			serve(command[0], result[1]);
+		}
+
+		close(command[0]);
+		close(result[1]);
+		worker.mPid = pid;
+		worker.mCommand = command[1];
+		worker.mResult = result[0];
+		worker.mCurrent = -1;
+		worker.mBuffer.clear();
+		return true;
+	}
+
+	/// <summary>
+	/// Main Loop of a Worker Process, never returns
+	/// </summary>
+	/// <param name="command">the Pipe the Test Indices arrive on</param>
+	/// <param name="result">the Pipe the Outcomes are sent on</param>
+	void ProcessRunner::serve(int command, int result) {
+		uint64_t index;
+		while (readAll(command, &index, sizeof(index))) {
+			Testable* test = mTests[static_cast<size_t>(index)];
+			TestCollection::runTest(test);
+
+			MessageWriter writer;
+			test->saveState(writer);
+
+			uint64_t header[2] = { index, writer.buffer().size() };
+			std::fflush(nullptr);
+			if (!writeAll(result, header, sizeof(header))
+				|| !writeAll(result, writer.buffer().data(), writer.buffer().size()))
+				break;
+		}
+
+		//the pending counts span all workers, so each tears down the copies it built itself
+		for (auto test : mTests)
+			for (auto fixture : test->mFixtures)
+				fixture->close();
+
+		//skip static destructors, they belong to the parent
+		std::fflush(nullptr);
+		_exit(0);
+	}
+
+	/// <summary>
+	/// Sends the next queued Test to an idle Worker
+	/// </summary>
+	/// <param name="worker">the idle Worker</param>
+	void ProcessRunner::dispatch(Worker& worker) {
+		if (mQueue.empty() || worker.mPid < 0 || worker.mCurrent >= 0) return;
+
+		uint64_t index = mQueue.front();
+		mQueue.pop_front();
+
+		//a worker that died meanwhile is noticed on its result pipe
+		if (!writeAll(worker.mCommand, &index, sizeof(index))) {
+			mQueue.push_front(static_cast<size_t>(index));
+			return;
+		}
+		worker.mCurrent = static_cast<int64_t>(index);
+		ReportQueue::testStart(mTests[static_cast<size_t>(index)]);
+
+		double timeout = mTests[static_cast<size_t>(index)]->getTimeout();
+		worker.mStarted = clock::now();
+		worker.mDeadline = timeout > 0
+			? worker.mStarted + std::chrono::duration_cast<clock::duration>(std::chrono::duration<double, std::milli>(timeout))
+			: clock::time_point::max();
+		worker.mKilled = false;
+	}
+
+	/// <summary>
+	/// Reads from a Worker and processes every complete Message
+	/// </summary>
+	/// <param name="worker">the Worker with Data available</param>
+	void ProcessRunner::receive(Worker& worker) {
+		char buffer[65536];
+		ssize_t count = read(worker.mResult, buffer, sizeof(buffer));
+		if (count < 0 && (errno == EINTR || errno == EAGAIN)) return;
+		if (count <= 0) {
+			bury(worker);
+			return;
+		}
+		worker.mBuffer.append(buffer, static_cast<size_t>(count));
+
+		while (worker.mBuffer.size() >= gHeaderSize) {
+			uint64_t header[2];
+			std::memcpy(header, worker.mBuffer.data(), gHeaderSize);
+
+			//the header comes from a process that may have corrupted itself, it must not crash the parent
+			if (worker.mCurrent < 0 || header[0] != static_cast<uint64_t>(worker.mCurrent) || header[1] > gMaxPayload) {
+				worker.mCorrupt = true;
+				kill(worker.mPid, SIGKILL);
+				bury(worker);
+				return;
+			}
+			if (worker.mBuffer.size() < gHeaderSize + header[1]) break;
+
+			Testable* test = mTests[static_cast<size_t>(header[0])];
+			MessageReader reader(worker.mBuffer.data() + gHeaderSize, static_cast<size_t>(header[1]));
+			if (!test->loadState(reader)) test->mResult.error("Malformed Result from Worker Process");
+			TestCollection::complete(test);
+
+			worker.mBuffer.erase(0, gHeaderSize + static_cast<size_t>(header[1]));
+			worker.mCurrent = -1;
+			mRemaining--;
+			dispatch(worker);
+		}
+	}
+
+	/// <summary>
+	/// Reaps a Worker that closed its Pipe, reports the Test it was running
+	/// as crashed and forks a Replacement if Tests are left
+	/// </summary>
+	/// <param name="worker">the dead Worker</param>
+	void ProcessRunner::bury(Worker& worker) {
+		int status = stop(worker);
+
+		if (worker.mCurrent >= 0) {
+			Testable* test = mTests[static_cast<size_t>(worker.mCurrent)];
+			std::string message;
+			if (worker.mKilled) {
+				test->mResult.timeout(worker.mLimit);
+			} else if (worker.mCorrupt) {
+				message = "Malformed Result from Worker Process";
+			} else if (WIFSIGNALED(status)) {
+				int signal = WTERMSIG(status);
+				message = "Crashed with Signal " + std::to_string(signal) + " (" + strsignal(signal) + ")";
+			} else if (WIFEXITED(status)) {
+				message = "Worker exited with Status " + std::to_string(WEXITSTATUS(status));
+			} else {
+				message = "Worker Process was lost";
+			}
+			if (!message.empty()) test->mResult.error(message);
+			TestCollection::complete(test);
+
+			worker.mCurrent = -1;
+			worker.mKilled = false;
+			mRemaining--;
+		}
+		worker.mCorrupt = false;
+
+		if (!mQueue.empty() && spawn(worker)) dispatch(worker);
+	}
+
+	/// <summary>
+	/// Closes the Pipes of a Worker and waits for it to exit
+	/// </summary>
+	/// <param name="worker">the Worker</param>
+	/// <returns>the Wait Status of the Process</returns>
+	int ProcessRunner::stop(Worker& worker) {
+		//closing the command pipe makes an idle worker exit
+		if (worker.mCommand >= 0) close(worker.mCommand);
+		if (worker.mResult >= 0) close(worker.mResult);
+		worker.mCommand = -1;
+		worker.mResult = -1;
+
+		int status = 0;
+		while (worker.mPid >= 0 && waitpid(worker.mPid, &status, 0) < 0 && errno == EINTR);
+		worker.mPid = -1;
+		return status;
+	}
+
+	/// <summary>
+	/// Kills the Workers whose Test ran out of Time
+	/// </summary>
+	/// <returns>the Milliseconds until the next Deadline, -1 when there is none</returns>
+	int ProcessRunner::expire() {
+		clock::time_point now = clock::now();
+		bool global = now >= mDeadline;
+
+		if (global) {
+			for (size_t index : mQueue) {
+				mTests[index]->mResult.error("Not run, the global Timeout expired");
+				TestCollection::complete(mTests[index]);
+				mRemaining--;
+			}
+			mQueue.clear();
+		}
+
+		clock::time_point next = mDeadline;
+		for (auto& worker : mWorkers) {
+			if (worker.mPid < 0 || worker.mCurrent < 0 || worker.mKilled) continue;
+
+			if (global || now >= worker.mDeadline) {
+				//the test is reported once the pipe of the dead worker closes
+				worker.mLimit = global && now < worker.mDeadline
+					? std::chrono::duration<double, std::milli>(now - worker.mStarted).count()
+					: mTests[static_cast<size_t>(worker.mCurrent)]->getTimeout();
+				worker.mKilled = true;
+				kill(worker.mPid, SIGKILL);
+			} else if (worker.mDeadline < next) {
+				next = worker.mDeadline;
+			}
+		}
+
+		if (global || next == clock::time_point::max()) return -1;
+		return static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(next - now).count()) + 1;
+	}
+
+	/// <summary>
+	/// Runs the queued Tests on the given Number of Workers
+	/// </summary>
+	/// <param name="processes">the Number of Worker Processes</param>
+	void ProcessRunner::runQueue(size_t processes) {
+		mRemaining = mQueue.size();
+		if (mRemaining == 0) return;
+
+		mWorkers.assign(std::min(processes, mRemaining), Worker());
+		for (auto& worker : mWorkers)
+			if (spawn(worker)) dispatch(worker);
+
+		std::vector<pollfd> fds;
+		std::vector<Worker*> owners;
+		while (mRemaining > 0) {
+			int timeout = expire();
+			if (mRemaining == 0) break;
+
+			fds.clear();
+			owners.clear();
+			for (auto& worker : mWorkers) {
+				if (worker.mPid < 0) continue;
+				fds.push_back({ worker.mResult, POLLIN, 0 });
+				owners.push_back(&worker);
+			}
+
+			//no worker could be started, the queued tests can't run
+			if (fds.empty()) {
+				for (size_t index : mQueue) {
+					mTests[index]->mResult.error("Failed to start Worker Process");
+					TestCollection::complete(mTests[index]);
+				}
+				mQueue.clear();
+				break;
+			}
+
+			if (poll(fds.data(), fds.size(), timeout) < 0) {
+				if (errno == EINTR) continue;
+				break;
+			}
+
+			for (size_t i = 0; i < fds.size(); i++)
+				if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) receive(*owners[i]);
+		}
+
+		for (auto& worker : mWorkers)
+			if (worker.mPid >= 0) stop(worker);
+		mWorkers.clear();
+	}
+
+	/// <summary>
+	/// Sets the Time all Tests have to be done by
+	/// </summary>
+	/// <param name="deadline">the global Deadline</param>
+	void ProcessRunner::setDeadline(clock::time_point deadline) {
+		mDeadline = deadline;
+	}
+
+	/// <summary>
+	/// Runs all Tests on the given Number of Workers
+	/// </summary>
+	/// <param name="processes">the Number of Worker Processes</param>
+	void ProcessRunner::run(size_t processes) {
+		//writing to a crashed worker must not kill the parent
+		struct sigaction ignore, previous;
+		std::memset(&ignore, 0, sizeof(ignore));
+		ignore.sa_handler = SIG_IGN;
+		sigaction(SIGPIPE, &ignore, &previous);
+
+		//tests are handed out in the order they were given
+		for (size_t i = 0; i < mTests.size(); i++)
+			mQueue.push_back(i);
+		runQueue(processes > 0 ? processes : 1);
+
+		sigaction(SIGPIPE, &previous, nullptr);
+	}
+
+	/// <summary>
+	/// returns weather running Tests in Processes is supported
+	/// </summary>
+	/// <returns>true on POSIX Systems</returns>
+	bool ProcessRunner::isSupported() {
+		return true;
+	}
+#else
+	bool ProcessRunner::spawn(Worker&) { return false; }
+	void ProcessRunner::serve(int, int) { std::abort(); }
+	void ProcessRunner::dispatch(Worker&) {}
+	void ProcessRunner::receive(Worker&) {}
+	void ProcessRunner::bury(Worker&) {}
+	int ProcessRunner::stop(Worker&) { return 0; }
+	int ProcessRunner::expire() { return -1; }
+	void ProcessRunner::setDeadline(clock::time_point) {}
+	void ProcessRunner::runQueue(size_t) {}
+	void ProcessRunner::run(size_t) {}
+	bool ProcessRunner::isSupported() { return false; }
+#endif
+}
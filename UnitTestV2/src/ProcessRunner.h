@@ -0,0 +1,141 @@
+#pragma once
+#ifndef UT_PROCESS_RUNNER_H
+#define UT_PROCESS_RUNNER_H
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+#include "Testable.h"
+
+namespace Test {
+
+	/// <summary>
+	/// Runs Tests in forked Worker Processes, so a Crash only takes down
+	/// the Worker and is reported as the Failure of the Test it was running.
+	/// Workers are forked from the fully registered Process and share its
+	/// Memory copy-on-write. The Parent hands out Test Indices over a Pipe,
+	/// Workers send the Outcome back over a second Pipe. Only on POSIX Systems.
+	/// </summary>
+	class ProcessRunner {
+	private:	//internal Defines
+		typedef std::chrono::steady_clock clock;
+
+	private:	//internal Class
+		/// <summary>
+		/// A Worker Process and the Parents Ends of its Pipes
+		/// </summary>
+		struct Worker {
+			int mPid = -1;
+			int mCommand = -1;
+			int mResult = -1;
+			int64_t mCurrent = -1;
+			std::string mBuffer;
+
+			clock::time_point mStarted;
+			clock::time_point mDeadline = clock::time_point::max();
+			double mLimit = 0;
+			bool mKilled = false;
+			bool mCorrupt = false;
+		};
+
+	private:	//private Members
+		std::vector<Testable*> mTests;
+		std::vector<Worker> mWorkers;
+		std::deque<size_t> mQueue;
+		size_t mRemaining = 0;
+		clock::time_point mDeadline = clock::time_point::max();
+
+	public:		//Constructors and Destructors
+		/// <summary>
+		/// Creates the Runner for the given Tests
+		/// </summary>
+		/// <param name="tests">the Tests, Indices into this List are sent to the Workers</param>
+		explicit ProcessRunner(const std::vector<Testable*>& tests);
+
+		ProcessRunner(const ProcessRunner&) = delete;
+
+		/// <summary>
+		/// Stops all remaining Workers
+		/// </summary>
+		~ProcessRunner();
+
+	private:	//internal Functionality
+		/// <summary>
+		/// Forks a new Worker into the given Slot
+		/// </summary>
+		/// <param name="worker">the Slot of the Worker</param>
+		/// <returns>false when the Fork failed</returns>
+		bool spawn(Worker& worker);
+
+		/// <summary>
+		/// Main Loop of a Worker Process, never returns
+		/// </summary>
+		/// <param name="command">the Pipe the Test Indices arrive on</param>
+		/// <param name="result">the Pipe the Outcomes are sent on</param>
+		[[noreturn]] void serve(int command, int result);
+
+		/// <summary>
+		/// Sends the next queued Test to an idle Worker
+		/// </summary>
+		/// <param name="worker">the idle Worker</param>
+		void dispatch(Worker& worker);
+
+		/// <summary>
+		/// Reads from a Worker and processes every complete Message, a Header not matching the current Test buries the Worker
+		/// </summary>
+		/// <param name="worker">the Worker with Data available</param>
+		void receive(Worker& worker);
+
+		/// <summary>
+		/// Reaps a Worker that closed its Pipe, reports the Test it was running
+		/// as crashed and forks a Replacement if Tests are left
+		/// </summary>
+		/// <param name="worker">the dead Worker</param>
+		void bury(Worker& worker);
+
+		/// <summary>
+		/// Closes the Pipes of a Worker and waits for it to exit
+		/// </summary>
+		/// <param name="worker">the Worker</param>
+		/// <returns>the Wait Status of the Process</returns>
+		int stop(Worker& worker);
+
+		/// <summary>
+		/// Kills the Workers whose Test ran out of Time. Once the global
+		/// Deadline passed all busy Workers are killed and the queued
+		/// Tests are reported as not run.
+		/// </summary>
+		/// <returns>the Milliseconds until the next Deadline, -1 when there is none</returns>
+		int expire();
+
+		/// <summary>
+		/// Runs the queued Tests on the given Number of Workers
+		/// </summary>
+		/// <param name="processes">the Number of Worker Processes</param>
+		void runQueue(size_t processes);
+
+	public:		//exposed Functionality
+		/// <summary>
+		/// Sets the Time all Tests have to be done by
+		/// </summary>
+		/// <param name="deadline">the global Deadline</param>
+		void setDeadline(clock::time_point deadline);
+
+		/// <summary>
+		/// Runs all Tests on the given Number of Workers
+		/// </summary>
+		/// <param name="processes">the Number of Worker Processes</param>
+		void run(size_t processes);
+
+		/// <summary>
+		/// returns weather running Tests in Processes is supported
+		/// </summary>
+		/// <returns>true on POSIX Systems</returns>
+		static bool isSupported();
+	};
+
+}
+
+#endif
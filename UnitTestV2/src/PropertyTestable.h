@@ -0,0 +1,324 @@
+#pragma once
+#ifndef UT_PROPERTY_TESTABLE_H
+#define UT_PROPERTY_TESTABLE_H
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "Testable.h"
+#include "Generators.h"
+#include "Stringify.h"
+#include "ThreadPool.h"
+
+//declares a Property Test, followed by the Body of the Property. The Body gets the
+//generated Values as the Tuple values and returns weather the Property holds.
+//It runs on many Threads at once, so it must not use the EXPECT Macros.
+#define PROPERTY(type, name, ...) \
+	class type : public std::remove_pointer_t<decltype(::Test::propertyOf(__VA_ARGS__))> {\
+	public:\
+		type() : base_type(name, __VA_ARGS__) { setLocation(UT_LOCATION); }\
+	protected:\
+		bool property(const values_type& values) override;\
+	};\
+	inline bool type::property(const values_type& values)
+
+namespace Test {
+
+	/// <summary>
+	/// A Test checking that a Property holds for randomly generated Values.
+	/// The Cases are generated and checked on several Threads. The first
+	/// failing Case is shrunk to a minimal Counterexample, which is reported
+	/// together with the Seed that reproduces it.
+	/// </summary>
+	/// <typeparam name="Ts">the Types of the generated Values</typeparam>
+	template<typename... Ts>
+	class PropertyTestable : public Testable {
+	public:		//definitions
+		typedef PropertyTestable base_type;
+		typedef std::tuple<Ts...> values_type;
+
+	private:	//private Members
+		std::tuple<Generator<Ts>...> mGenerators;
+		const SourceLocation* mLocation;
+
+		uint64_t mSeed = 0;
+		size_t mCases = 100;
+		size_t mThreads = 1;
+		size_t mShrinkLimit = 1000;
+
+		uint64_t mUsedSeed = 0;
+		uint64_t mChecked = 0;
+
+	public:		//Constructors and Destructors
+		/// <summary>
+		/// Creates the Property Test and registers it with the Framework
+		/// </summary>
+		/// <param name="name">the Name of the Test</param>
+		/// <param name="generators">the Generators of the Values, one per Argument</param>
+		PropertyTestable(const std::string& name, Generator<Ts>... generators)
+			: Testable(name), mGenerators(std::move(generators)...) {
+			static constexpr SourceLocation unknown{ "property", 0 };
+			mLocation = &unknown;
+		}
+
+	private:	//internal functionality
+		/// <summary>
+		/// returns the Seed of a single Case, so every Case can be generated on its own
+		/// </summary>
+		/// <param name="index">the Index of the Case</param>
+		/// <returns>the Seed</returns>
+		uint64_t caseSeed(uint64_t index) const {
+			//splitmix64, neighbouring indices give unrelated seeds
+			uint64_t z = mUsedSeed + (index + 1) * 0x9e3779b97f4a7c15ull;
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+			return z ^ (z >> 31);
+		}
+
+		/// <summary>
+		/// Generates the Values of a Case
+		/// </summary>
+		/// <param name="index">the Index of the Case</param>
+		/// <returns>the Values</returns>
+		values_type generate(uint64_t index) const {
+			return generate(index, std::index_sequence_for<Ts...>());
+		}
+
+		template<size_t... I>
+		values_type generate(uint64_t index, std::index_sequence<I...>) const {
+			Random random(caseSeed(index));
+			//a braced list is evaluated left to right, so the values don't depend on the compiler
+			return values_type{ std::get<I>(mGenerators).mGenerate(random)... };
+		}
+
+		/// <summary>
+		/// Checks the Property, an Exception counts as not holding
+		/// </summary>
+		/// <param name="values">the Values</param>
+		/// <param name="error">receives the Message of an Exception, may be nullptr</param>
+		/// <returns>true when the Property holds</returns>
+		bool holds(const values_type& values, std::string* error) {
+			try {
+				return property(values);
+			} catch (std::exception& e) {
+				if (error) *error = e.what();
+			} catch (...) {
+				if (error) *error = "Unknown Error";
+			}
+			return false;
+		}
+
+		/// <summary>
+		/// Tries the simpler Variants of one Value, keeps the first that still fails
+		/// </summary>
+		/// <param name="values">the failing Values, replaced by simpler ones</param>
+		/// <param name="budget">the Number of Checks left</param>
+		/// <returns>true when a simpler failing Variant was found</returns>
+		template<size_t I>
+		bool shrinkValue(values_type& values, size_t& budget) {
+			for (auto&& candidate : std::get<I>(mGenerators).mShrink(std::get<I>(values))) {
+				if (budget == 0) return false;
+				budget--;
+
+				values_type changed = values;
+				std::get<I>(changed) = std::move(candidate);
+				if (!holds(changed, nullptr)) {
+					values = std::move(changed);
+					return true;
+				}
+			}
+			return false;
+		}
+
+		template<size_t... I>
+		bool shrinkStep(values_type& values, size_t& budget, std::index_sequence<I...>) {
+			//shrinks the first value that can be shrunk
+			return (shrinkValue<I>(values, budget) || ...);
+		}
+
+		/// <summary>
+		/// Shrinks failing Values until no simpler Variant fails
+		/// </summary>
+		/// <param name="values">the failing Values, replaced by the minimal ones</param>
+		/// <returns>the Number of Shrinking Steps taken</returns>
+		size_t shrink(values_type& values) {
+			size_t budget = mShrinkLimit;
+			size_t steps = 0;
+			while (!shouldStop() && shrinkStep(values, budget, std::index_sequence_for<Ts...>()))
+				steps++;
+			return steps;
+		}
+
+		/// <summary>
+		/// Formats the Values as an Argument List
+		/// </summary>
+		/// <param name="values">the Values</param>
+		/// <returns>the formatted Values</returns>
+		static std::string format(const values_type& values) {
+			std::string text = "(";
+			std::apply([&text](const Ts&... value) {
+				size_t index = 0;
+				((text += (index++ ? ", " : "") + stringify(value)), ...);
+			}, values);
+			return text + ')';
+		}
+
+	protected:	//protected functionality (to get overrides from childclasses)
+		/// <summary>
+		/// The Property that has to hold for all Values. Called from several Threads at once.
+		/// </summary>
+		/// <param name="values">the generated Values</param>
+		/// <returns>true when the Property holds</returns>
+		virtual bool property(const values_type& values) = 0;
+
+		/// <summary>
+		/// Generates and checks the Cases, then shrinks the first failing one
+		/// </summary>
+		void run() final {
+			mUsedSeed = mSeed != 0 ? mSeed : (uint64_t(std::random_device()()) << 32) | std::random_device()();
+
+			//the lowest failing index wins, so the result doesn't depend on the number of threads
+			std::atomic<uint64_t> next{ 0 };
+			std::atomic<uint64_t> failed{ mCases };
+			std::atomic<uint64_t> checked{ 0 };
+			auto work = [&]() {
+				for (;;) {
+					uint64_t index = next.fetch_add(1, std::memory_order_relaxed);
+					if (index >= failed.load(std::memory_order_relaxed) || shouldStop()) return;
+					checked.fetch_add(1, std::memory_order_relaxed);
+					if (holds(generate(index), nullptr)) continue;
+
+					uint64_t current = failed.load(std::memory_order_relaxed);
+					while (index < current && !failed.compare_exchange_weak(current, index, std::memory_order_relaxed)) {}
+				}
+			};
+
+			size_t threads = std::min<size_t>(mThreads ? mThreads : ThreadPool::defaultSize(), mCases);
+			if (threads <= 1) {
+				work();
+			} else {
+				ThreadPool pool(threads);
+				for (size_t i = 0; i < threads; i++) pool.submit(i, work);
+				pool.wait();
+			}
+			mChecked = checked.load();
+
+			uint64_t index = failed.load();
+			if (index >= mCases) return;
+
+			values_type original = generate(index);
+			values_type minimal = original;
+			size_t steps = shrink(minimal);
+			std::string error;
+			holds(minimal, &error);
+
+			std::string message = "seed " + std::to_string(mUsedSeed) + ", case #" + std::to_string(index)
+				+ ": counterexample " + format(minimal);
+			if (steps > 0) message += ", shrunk from " + format(original) + " in " + std::to_string(steps) + " steps";
+			if (!error.empty()) message += ", threw: " + error;
+			mResult.fail("PROPERTY does not hold", *mLocation, message);
+		}
+
+		/// <summary>
+		/// Writes the Number of Cases and the Seed to the Report
+		/// </summary>
+		/// <param name="stream">the stream to write to</param>
+		/// <param name="indent">the Width of the Labels</param>
+		void reportDetails(std::ostream& stream, uint32_t indent) const override {
+			stream << std::setw(indent) << std::left << "Cases: " << mChecked << '\n'
+				<< std::setw(indent) << std::left << "Seed: " << mUsedSeed << '\n';
+		}
+
+		/// <summary>
+		/// Writes the Outcome, the Number of Cases and the Seed to a Message
+		/// </summary>
+		/// <param name="writer">the Message to write to</param>
+		void saveState(MessageWriter& writer) const override {
+			Testable::saveState(writer);
+			writer.write(mChecked);
+			writer.write(mUsedSeed);
+		}
+
+		/// <summary>
+		/// Reads the Outcome, the Number of Cases and the Seed from a Message
+		/// </summary>
+		/// <param name="reader">the Message to read from</param>
+		/// <returns>false when the Message is malformed</returns>
+		bool loadState(MessageReader& reader) override {
+			return Testable::loadState(reader) && reader.read(mChecked) && reader.read(mUsedSeed);
+		}
+
+		/// <summary>
+		/// Forgets the Cases of the last Run
+		/// </summary>
+		void reset() override {
+			Testable::reset();
+			mChecked = 0;
+		}
+
+		/// <summary>
+		/// Sets the Location reported with a Counterexample
+		/// </summary>
+		/// <param name="location">the File and Line of the Property</param>
+		void setLocation(const SourceLocation& location) {
+			mLocation = &location;
+		}
+
+	public:		//getters and setters
+		/// <summary>
+		/// Sets the Seed of the Random Values, to reproduce a reported Counterexample
+		/// </summary>
+		/// <param name="seed">the Seed, 0 for a new random Seed every Run</param>
+		void setSeed(uint64_t seed) {
+			mSeed = seed;
+		}
+
+		/// <summary>
+		/// Sets the Number of Cases checked
+		/// </summary>
+		/// <param name="cases">the Number of Cases</param>
+		void setCases(size_t cases) {
+			mCases = cases;
+		}
+
+		/// <summary>
+		/// Sets the Number of Threads generating and checking Cases.
+		/// Properties already run on the Suite's Thread Pool, so they use a single Thread
+		/// unless more are requested here.
+		/// </summary>
+		/// <param name="threads">the Number of Threads, 0 for one per Core</param>
+		void setThreads(size_t threads) {
+			mThreads = threads;
+		}
+
+		/// <summary>
+		/// Sets the Number of Checks spent on shrinking a Counterexample
+		/// </summary>
+		/// <param name="limit">the Number of Checks</param>
+		void setShrinkLimit(size_t limit) {
+			mShrinkLimit = limit;
+		}
+
+		/// <summary>
+		/// Returns the Seed of the last Run
+		/// </summary>
+		/// <returns>the Seed</returns>
+		uint64_t getSeed() const {
+			return mUsedSeed;
+		}
+	};
+
+	/// <summary>
+	/// Names the PropertyTestable for a List of Generators, used by the PROPERTY Macro
+	/// </summary>
+	template<typename... Ts>
+	PropertyTestable<Ts...>* propertyOf(const Generator<Ts>&...);
+
+}
+
+#endif
@@ -0,0 +1,264 @@
+#include "ReportQueue.h"
+#include "OutputCapture.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+
+namespace Test {
+
+	namespace {
+		/// <summary>
+		/// Copies a String to the Storage behind a Node and advances the Storage
+		/// </summary>
+		/// <param name="storage">the next free Byte, moved past the Copy</param>
+		/// <param name="text">the null terminated String</param>
+		/// <param name="size">the Size of the String including the Terminator</param>
+		/// <returns>the Copy</returns>
+		const char* append(char*& storage, const char* text, size_t size) {
+			char* copy = storage;
+			std::memcpy(copy, text, size);
+			storage += size;
+			return copy;
+		}
+	}
+
+
+	/// <summary>
+	/// Creates an empty Queue
+	/// </summary>
+	ReportQueue::ReportQueue() : mHead(&mStub), mTail(&mStub) {
+		mStub.mNext.store(nullptr, std::memory_order_relaxed);
+	}
+
+	/// <summary>
+	/// Get the Instance of the ReportQueue
+	/// </summary>
+	/// <returns>a Reference to the Instance</returns>
+	ReportQueue& ReportQueue::Instance() {
+		//initialized thread safe on first use and destroyed at exit
+		static ReportQueue instance;
+		return instance;
+	}
+
+	/// <summary>
+	/// Queues an Event, called by any Thread
+	/// </summary>
+	/// <param name="node">the Event, owned by the Queue from now on</param>
+	void ReportQueue::push(Node* node) {
+		node->mNext.store(nullptr, std::memory_order_relaxed);
+		//the exchange orders the producers, the link makes the node visible to the writer
+		Node* previous = mHead.exchange(node, std::memory_order_acq_rel);
+		previous->mNext.store(node, std::memory_order_release);
+	}
+
+	/// <summary>
+	/// Takes the oldest Event, only called by the Writer Thread
+	/// </summary>
+	/// <returns>the Event or nullptr when none is complete yet</returns>
+	ReportQueue::Node* ReportQueue::pop() {
+		Node* tail = mTail;
+		Node* next = tail->mNext.load(std::memory_order_acquire);
+
+		if (tail == &mStub) {
+			if (!next) return nullptr;
+			mTail = next;
+			tail = next;
+			next = next->mNext.load(std::memory_order_acquire);
+		}
+
+		if (next) {
+			mTail = next;
+			return tail;
+		}
+
+		//a producer swapped the head but did not link its node yet
+		if (tail != mHead.load(std::memory_order_acquire)) return nullptr;
+
+		//the last node can only be taken once the stub is behind it
+		push(&mStub);
+		next = tail->mNext.load(std::memory_order_acquire);
+		if (!next) return nullptr;
+		mTail = next;
+		return tail;
+	}
+
+	/// <summary>
+	/// Hands an Event to all Reporters
+	/// </summary>
+	/// <param name="node">the Event</param>
+	void ReportQueue::deliver(const Node& node) {
+		for (auto reporter : mReporters) {
+			switch (node.mType) {
+			case SuiteStart:
+				reporter->suiteStart(node.mCount);
+				break;
+			case TestStart:
+				reporter->testStart(*node.mTest);
+				break;
+			case AssertionFailed:
+				reporter->assertionFailed(*node.mTest, node.mCode, node.mLocation, node.mValues);
+				break;
+			case TestEnd:
+				reporter->testEnd(*node.mTest);
+				break;
+			case SuiteEnd:
+				reporter->suiteEnd(*node.mSummary);
+				break;
+			}
+		}
+	}
+
+	/// <summary>
+	/// Main Loop of the Writer Thread
+	/// </summary>
+	void ReportQueue::write() {
+		//reporters to std::cout stream to the console, even while stdout is captured
+		OutputCapture::attach(OutputCapture::console(), nullptr);
+
+		for (;;) {
+			if (Node* node = pop()) {
+				deliver(*node);
+				std::free(node);
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(mMutex);
+			if (mStopping) {
+				//stop is only called after the last event was posted
+				lock.unlock();
+				while (Node* node = pop()) {
+					deliver(*node);
+					std::free(node);
+				}
+				std::cout.flush();
+				OutputCapture::detach();
+				return;
+			}
+
+			//producers only notify a sleeping writer and never take the lock,
+			//a wakeup they miss is made up by the timeout
+			mSleeping.store(true, std::memory_order_seq_cst);
+			if (mTail->mNext.load(std::memory_order_acquire) == nullptr && mTail == mHead.load(std::memory_order_acquire))
+				mWake.wait_for(lock, std::chrono::milliseconds(10));
+			mSleeping.store(false, std::memory_order_relaxed);
+		}
+	}
+
+	/// <summary>
+	/// Allocates and queues an Event, when the Queue is running
+	/// </summary>
+	void ReportQueue::post(EventType type, const Testable* test, const char* code,
+		const SourceLocation* location, const char* values, size_t count, const RunSummary* summary) {
+		ReportQueue& instance = Instance();
+		if (!instance.mActive.load(std::memory_order_acquire)) return;
+
+		size_t codeSize = code ? std::strlen(code) + 1 : 0;
+		size_t fileSize = location ? std::strlen(location->mFile) + 1 : 0;
+		size_t valuesSize = values ? std::strlen(values) + 1 : 0;
+
+		Node* node = static_cast<Node*>(std::malloc(sizeof(Node) + codeSize + fileSize + valuesSize));
+		if (!node) return;
+		new (node) Node();
+		node->mType = type;
+		node->mTest = test;
+
+		char* storage = reinterpret_cast<char*>(node + 1);
+		node->mCode = code ? append(storage, code, codeSize) : nullptr;
+		node->mLocation.mFile = location ? append(storage, location->mFile, fileSize) : nullptr;
+		node->mLocation.mLine = location ? location->mLine : 0;
+		node->mValues = values ? append(storage, values, valuesSize) : nullptr;
+		node->mCount = count;
+		node->mSummary = summary;
+
+		instance.push(node);
+		if (instance.mSleeping.load(std::memory_order_seq_cst)) instance.mWake.notify_one();
+	}
+
+	/// <summary>
+	/// Adds a Reporter, all Reporters get every Event
+	/// </summary>
+	/// <param name="reporter">the Reporter, it has to outlive the Run</param>
+	void ReportQueue::addReporter(Reporter* reporter) {
+		Instance().mReporters.push_back(reporter);
+	}
+
+	/// <summary>
+	/// Starts the Writer Thread when there are Reporters
+	/// </summary>
+	void ReportQueue::start() {
+		ReportQueue& instance = Instance();
+		if (instance.mReporters.empty() || instance.mWriter.joinable()) return;
+
+		instance.mStopping = false;
+		instance.mActive.store(true, std::memory_order_release);
+		instance.mWriter = std::thread(&ReportQueue::write, &instance);
+	}
+
+	/// <summary>
+	/// Delivers all queued Events and stops the Writer Thread
+	/// </summary>
+	void ReportQueue::stop() {
+		ReportQueue& instance = Instance();
+		if (!instance.mWriter.joinable()) return;
+
+		instance.mActive.store(false, std::memory_order_release);
+		{
+			std::lock_guard<std::mutex> lock(instance.mMutex);
+			instance.mStopping = true;
+		}
+		instance.mWake.notify_one();
+		instance.mWriter.join();
+	}
+
+	/// <summary>
+	/// Stops accepting Events without touching the Writer Thread
+	/// </summary>
+	void ReportQueue::disable() {
+		Instance().mActive.store(false, std::memory_order_relaxed);
+	}
+
+	/// <summary>
+	/// Posts the Start of the Run
+	/// </summary>
+	/// <param name="tests">the Number of Tests that will run</param>
+	void ReportQueue::suiteStart(size_t tests) {
+		post(SuiteStart, nullptr, nullptr, nullptr, nullptr, tests);
+	}
+
+	/// <summary>
+	/// Posts the Start of a Test
+	/// </summary>
+	/// <param name="test">the Test</param>
+	void ReportQueue::testStart(const Testable* test) {
+		post(TestStart, test);
+	}
+
+	/// <summary>
+	/// Posts a failed Check
+	/// </summary>
+	/// <param name="test">the Test</param>
+	/// <param name="code">the Code that was checked</param>
+	/// <param name="location">the File and Line of the Check</param>
+	/// <param name="values">the formatted Values or nullptr</param>
+	void ReportQueue::assertionFailed(const Testable* test, const char* code, const SourceLocation& location, const char* values) {
+		post(AssertionFailed, test, code, &location, values);
+	}
+
+	/// <summary>
+	/// Posts the End of a Test
+	/// </summary>
+	/// <param name="test">the Test</param>
+	void ReportQueue::testEnd(const Testable* test) {
+		post(TestEnd, test);
+	}
+
+	/// <summary>
+	/// Posts the End of the Run
+	/// </summary>
+	/// <param name="summary">the Totals, they have to stay valid until stop</param>
+	void ReportQueue::suiteEnd(const RunSummary* summary) {
+		post(SuiteEnd, nullptr, nullptr, nullptr, nullptr, 0, summary);
+	}
+}
@@ -0,0 +1,166 @@
+#pragma once
+#ifndef UT_REPORT_QUEUE_H
+#define UT_REPORT_QUEUE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Reporter.h"
+
+namespace Test {
+
+	/// <summary>
+	/// Delivers Reporter Events from the Worker Threads to a single Writer Thread.
+	/// Posting an Event is wait free: Workers push onto a lock free
+	/// multi Producer single Consumer Queue and never wait on a Reporter.
+	/// Events of one Thread arrive in the Order they were posted.
+	/// </summary>
+	class ReportQueue {
+	private:	//internal Defines
+		enum EventType {
+			SuiteStart,
+			TestStart,
+			AssertionFailed,
+			TestEnd,
+			SuiteEnd
+		};
+
+		/// <summary>
+		/// An Event and the Link to the next one. Nodes are allocated with
+		/// malloc, so they don't show up in the Allocations of the posting Test.
+		/// The Strings of a failed Check are copied behind the Node, the Test
+		/// may be reset and its Results freed before the Event is delivered.
+		/// </summary>
+		struct Node {
+			std::atomic<Node*> mNext;
+			EventType mType;
+			const Testable* mTest;
+			const char* mCode;
+			SourceLocation mLocation;
+			const char* mValues;
+			size_t mCount;
+			const RunSummary* mSummary;
+		};
+
+	private:	//private Members
+		std::vector<Reporter*> mReporters;
+
+		std::atomic<Node*> mHead;
+		Node* mTail;
+		Node mStub;
+
+		std::atomic<bool> mActive{ false };
+		std::atomic<bool> mSleeping{ false };
+		bool mStopping = false;
+		std::mutex mMutex;
+		std::condition_variable mWake;
+		std::thread mWriter;
+
+	public:		//Constructors and Destructors
+		/// <summary>
+		/// Creates an empty Queue
+		/// </summary>
+		ReportQueue();
+
+		ReportQueue(const ReportQueue&) = delete;
+
+	private:	//internal Functionality
+		/// <summary>
+		/// Get the Instance of the ReportQueue
+		/// </summary>
+		/// <returns>a Reference to the Instance</returns>
+		static ReportQueue& Instance();
+
+		/// <summary>
+		/// Queues an Event, called by any Thread
+		/// </summary>
+		/// <param name="node">the Event, owned by the Queue from now on</param>
+		void push(Node* node);
+
+		/// <summary>
+		/// Takes the oldest Event, only called by the Writer Thread
+		/// </summary>
+		/// <returns>the Event or nullptr when none is complete yet</returns>
+		Node* pop();
+
+		/// <summary>
+		/// Hands an Event to all Reporters
+		/// </summary>
+		/// <param name="node">the Event</param>
+		void deliver(const Node& node);
+
+		/// <summary>
+		/// Main Loop of the Writer Thread
+		/// </summary>
+		void write();
+
+		/// <summary>
+		/// Allocates and queues an Event, when the Queue is running
+		/// </summary>
+		static void post(EventType type, const Testable* test, const char* code = nullptr,
+			const SourceLocation* location = nullptr, const char* values = nullptr,
+			size_t count = 0, const RunSummary* summary = nullptr);
+
+	public:		//exposed Functionality
+		/// <summary>
+		/// Adds a Reporter, all Reporters get every Event.
+		/// Only call this while no Run is in Progress.
+		/// </summary>
+		/// <param name="reporter">the Reporter, it has to outlive the Run</param>
+		static void addReporter(Reporter* reporter);
+
+		/// <summary>
+		/// Starts the Writer Thread when there are Reporters
+		/// </summary>
+		static void start();
+
+		/// <summary>
+		/// Delivers all queued Events and stops the Writer Thread
+		/// </summary>
+		static void stop();
+
+		/// <summary>
+		/// Stops accepting Events without touching the Writer Thread.
+		/// Used in forked Processes, which don't have the Thread.
+		/// </summary>
+		static void disable();
+
+		/// <summary>
+		/// Posts the Start of the Run
+		/// </summary>
+		/// <param name="tests">the Number of Tests that will run</param>
+		static void suiteStart(size_t tests);
+
+		/// <summary>
+		/// Posts the Start of a Test
+		/// </summary>
+		/// <param name="test">the Test</param>
+		static void testStart(const Testable* test);
+
+		/// <summary>
+		/// Posts a failed Check, Code, Location and Values are copied into the Event
+		/// </summary>
+		/// <param name="test">the Test</param>
+		/// <param name="code">the Code that was checked</param>
+		/// <param name="location">the File and Line of the Check</param>
+		/// <param name="values">the formatted Values or nullptr</param>
+		static void assertionFailed(const Testable* test, const char* code, const SourceLocation& location, const char* values);
+
+		/// <summary>
+		/// Posts the End of a Test, the Test must not change afterwards
+		/// </summary>
+		/// <param name="test">the Test</param>
+		static void testEnd(const Testable* test);
+
+		/// <summary>
+		/// Posts the End of the Run
+		/// </summary>
+		/// <param name="summary">the Totals, they have to stay valid until stop</param>
+		static void suiteEnd(const RunSummary* summary);
+	};
+
+}
+
+#endif
@@ -0,0 +1,211 @@
+#include "Reporter.h"
+#include "Testable.h"
+#include "TestCollection.h"
+#include <iomanip>
+
+namespace Test {
+	namespace {
+		/// <summary>
+		/// ANSI Escape Sequences used by the TextReporter, empty without Color
+		/// </summary>
+		struct Palette {
+			const char* mReset;
+			const char* mGreen;
+			const char* mRed;
+			const char* mYellow;
+			const char* mOrange;
+		};
+
+		constexpr Palette gColors = { "\x1b[0m", "\x1b[38;5;40m", "\x1b[38;5;160m", "\x1b[38;5;226m", "\x1b[38;5;208m" };
+		constexpr Palette gPlain = { "", "", "", "", "" };
+
+		constexpr uint32_t gSeperatorWidth = 90;
+		constexpr uint32_t gIndent = 14;
+
+		/// <summary>
+		/// Writes the valid Performance Counters of a Test
+		/// </summary>
+		/// <param name="stream">the stream to write to</param>
+		/// <param name="counters">the recorded Counters</param>
+		/// <param name="indent">the Width of the Labels</param>
+		void reportCounters(std::ostream& stream, const PerfCounters::Values& counters, uint32_t indent) {
+			static constexpr const char* labels[PerfCounters::CounterCount] = {
+				"Cycles: ", "Instructions: ", "Cache Miss: ", "Branch Miss: ", "Ctx Switches: "
+			};
+
+			for (int i = 0; i < PerfCounters::CounterCount; i++) {
+				if (!counters.mValid[i]) continue;
+				stream << std::setw(indent) << std::left << labels[i] << counters.mValues[i];
+
+				//instructions per cycle tell compute bound (high) from memory bound (low)
+				if (i == PerfCounters::Instructions && counters.mValid[PerfCounters::Cycles] && counters.mValues[PerfCounters::Cycles] > 0)
+					stream << " (IPC " << static_cast<double>(counters.mValues[i]) / counters.mValues[PerfCounters::Cycles] << ')';
+				stream << '\n';
+			}
+		}
+	}
+
+
+	/// <summary>
+	/// The Run starts
+	/// </summary>
+	/// <param name="tests">the Number of Tests that will run</param>
+	void Reporter::suiteStart(size_t) {}
+
+	/// <summary>
+	/// A Test starts, only its Name may be read yet
+	/// </summary>
+	/// <param name="test">the Test</param>
+	void Reporter::testStart(const Testable&) {}
+
+	/// <summary>
+	/// A Check of a running Test failed
+	/// </summary>
+	/// <param name="test">the Test, only its Name may be read yet</param>
+	/// <param name="code">the Code that was checked</param>
+	/// <param name="location">the File and Line of the Check</param>
+	/// <param name="values">the formatted Values or nullptr</param>
+	void Reporter::assertionFailed(const Testable&, const char*, const SourceLocation&, const char*) {}
+
+	/// <summary>
+	/// A Test finished
+	/// </summary>
+	/// <param name="test">the Test</param>
+	void Reporter::testEnd(const Testable&) {}
+
+	/// <summary>
+	/// The Run finished
+	/// </summary>
+	/// <param name="summary">the Totals of the Run</param>
+	void Reporter::suiteEnd(const RunSummary&) {}
+
+
+	/// <summary>
+	/// Creates a Reporter writing to a Stream
+	/// </summary>
+	/// <param name="stream">the Stream to write to</param>
+	/// <param name="color">true to use ANSI Colors</param>
+	TextReporter::TextReporter(std::ostream& stream, bool color) : mStream(stream), mColor(color) {}
+
+	/// <summary>
+	/// Creates a Reporter writing to a File
+	/// </summary>
+	/// <param name="path">the File to write</param>
+	TextReporter::TextReporter(const std::string& path) : mFile(path), mStream(mFile), mColor(false) {}
+
+	/// <summary>
+	/// Writes the Headline
+	/// </summary>
+	/// <param name="tests">the Number of Tests that will run</param>
+	void TextReporter::suiteStart(size_t) {
+		mStream << "Unit Test Report:\n";
+	}
+
+	/// <summary>
+	/// Writes the Block of a finished Test
+	/// </summary>
+	/// <param name="test">the Test</param>
+	void TextReporter::testEnd(const Testable& test) {
+		const Palette& colors = mColor ? gColors : gPlain;
+		std::string name(test.getName());
+
+		mStream << std::setw(gSeperatorWidth) << std::left << std::setfill('=')
+			<< std::string(gSeperatorWidth / 2 - name.size() / 2 - 2, '=') + '[' + name + ']' << '\n'
+			<< std::setfill(' ');
+
+		//the thread of an abandoned test may still write to it, only its name is safe to read
+		if (test.isAbandoned()) {
+			mStream << std::setw(gIndent) << "Status: " << colors.mRed << "timed out" << colors.mReset << "\nReport:\n"
+				<< std::setw(gIndent) << "Error: " << "Abandoned after the global Timeout, still running\n";
+			mStream.flush();
+			return;
+		}
+
+		mStream
+			<< std::setw(gIndent) << "Duration: " << test.getTime().count() << "ms\n"
+			<< std::setw(gIndent) << "Status: ";
+		if (test.hasFailed()) {
+			mStream << colors.mRed << (test.getResults().hasTimedOut() ? "timed out" : "failed") << colors.mReset << "\nReport:\n";
+			test.getResults().reportFails(mStream, gIndent);
+			test.getResults().reportError(mStream, gIndent);
+			if (test.getResults().getAttempts() > 1)
+				mStream << std::setw(gIndent) << "Attempts: " << test.getResults().getAttempts() << ", all failed\n";
+		} else if (test.getResults().isFlaky()) {
+			//passed on a retry, the failure of the first attempt is what needs fixing
+			mStream << colors.mOrange << "flaky" << colors.mReset << '\n'
+				<< std::setw(gIndent) << "Attempts: " << test.getResults().getAttempts()
+				<< ", the first failed: " << test.getResults().getRetryCause() << '\n';
+		} else if (test.isRegressed()) {
+			const Timing* baseline = test.getBaseline();
+			Timing timing = test.getTiming();
+			mStream << colors.mOrange << "perf-regressed" << colors.mReset << '\n'
+				<< std::setw(gIndent) << "Baseline: " << baseline->mMean
+				<< " (now " << timing.mMean << ", +"
+				<< (timing.mMean / baseline->mMean - 1) * 100 << "%)\n";
+		} else mStream << colors.mGreen << "passed" << colors.mReset << '\n';
+
+		reportCounters(mStream, test.getCounters(), gIndent);
+		if (TestCollection::isAllocationTracking() && AllocationTracker::isEnabled())
+			mStream << std::setw(gIndent) << "Allocations: " << test.getAllocations().mAllocations
+			<< " (" << test.getAllocations().mBytes << " bytes, peak "
+			<< test.getAllocations().mPeak << " bytes live)\n";
+		test.reportDetails(mStream, gIndent);
+		mStream.flush();
+	}
+
+	/// <summary>
+	/// Writes the Conclusion
+	/// </summary>
+	/// <param name="summary">the Totals of the Run</param>
+	void TextReporter::suiteEnd(const RunSummary& summary) {
+		const Palette& colors = mColor ? gColors : gPlain;
+
+		//green: all tests passed
+		//red: all tests failed
+		//yellow: both failed and passed tests
+		//orange: no tests being run
+		const char* color = colors.mOrange;
+		if (summary.mFailed > 0 && summary.mPassed > 0) color = colors.mYellow;
+		else if (summary.mFailed > 0) color = colors.mRed;
+		else if (summary.mPassed > 0) color = colors.mGreen;
+
+		mStream << std::left << std::setfill(' ') << std::string(gSeperatorWidth, '=') << '\n'
+			<< color << "Conclusion: " << colors.mReset << '\n'
+			<< std::setw(gIndent) << "Failed Tests: " << summary.mFailed << '\n'
+			<< std::setw(gIndent) << "Passed Tests: " << summary.mPassed << '\n';
+		if (summary.mFlaky > 0)
+			mStream << std::setw(gIndent) << "Flaky Tests: " << summary.mFlaky << " (passed on a Retry)\n";
+		mStream << std::setw(gIndent) << "Duration: " << summary.mDuration << "ms\n";
+
+		if (summary.mEfficiency >= 0)
+			mStream << std::setw(gIndent) << "Scheduling Efficiency: " << summary.mEfficiency * 100 << "%\n";
+
+		if (summary.mShardCount > 1)
+			mStream << std::setw(gIndent) << "Shard: " << summary.mShardIndex + 1 << " of " << summary.mShardCount << '\n';
+		if (summary.mIteration > 0)
+			mStream << std::setw(gIndent) << "Iteration: " << summary.mIteration << '\n';
+		if (summary.mSeed != 0)
+			mStream << std::setw(gIndent) << "Seed: " << summary.mSeed << " (replay the Order with --seed)\n";
+		if (summary.mDeselected > 0)
+			mStream << std::setw(gIndent) << "Deselected: " << summary.mDeselected << " Tests\n";
+
+		if (summary.mHasBaseline)
+			mStream << std::setw(gIndent) << "Regressed: " << summary.mRegressed << '\n';
+
+		//fixture builds are not part of any test's duration
+		if (!summary.mFixtures.empty()) {
+			mStream << "Fixtures: \n";
+			for (const auto& fixture : summary.mFixtures) {
+				mStream << std::setw(gIndent) << fixture.mName + ": ";
+				if (!fixture.mError.empty()) mStream << colors.mRed << "failed" << colors.mReset << " (" << fixture.mError << ")";
+				else if (fixture.mBuildTime > 0) mStream << "built in " << fixture.mBuildTime << "ms";
+				else mStream << "not built in this Process";
+				mStream << " for " << fixture.mUsers << " Tests\n";
+			}
+		}
+
+		if (!summary.mRawOutput.empty())
+			mStream << "Raw Output: \n" << summary.mRawOutput;
+		mStream.flush();
+	}
+}
@@ -0,0 +1,125 @@
+#pragma once
+#ifndef UT_REPORTER_H
+#define UT_REPORTER_H
+
+#include <cstdint>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "utCommon.h"
+
+namespace Test {
+
+	class Testable;
+
+	/// <summary>
+	/// Build Time of a shared Fixture, reported apart from the Tests using it
+	/// </summary>
+	struct FixtureSummary {
+		std::string mName;
+		uint64_t mUsers = 0;
+		double mBuildTime = 0;
+		std::string mError;
+	};
+
+	/// <summary>
+	/// Totals of a finished Run, handed to Reporter::suiteEnd
+	/// </summary>
+	struct RunSummary {
+		uint64_t mFailed = 0;
+		uint64_t mPassed = 0;
+		uint64_t mRegressed = 0;
+		uint64_t mFlaky = 0;
+		bool mHasBaseline = false;
+		double mDuration = 0;
+		double mEfficiency = -1;
+		double mTimeout = 0;
+		size_t mShardIndex = 0;
+		size_t mShardCount = 1;
+		uint64_t mDeselected = 0;
+		uint64_t mIteration = 0;
+		uint64_t mSeed = 0;
+		std::string mRawOutput;
+		std::vector<FixtureSummary> mFixtures;
+	};
+
+	/// <summary>
+	/// Receives the Events of a Run. All Events are delivered on one Thread
+	/// in the Order they happened, so a Reporter needs no Locking. A Test
+	/// passed to testEnd is finished and may be read freely, except when it
+	/// was abandoned (Testable::isAbandoned), then only its Name is safe.
+	/// </summary>
+	class Reporter {
+	public:		//Constructors and Destructors
+		virtual ~Reporter() = default;
+
+	public:		//Events
+		/// <summary>
+		/// The Run starts
+		/// </summary>
+		/// <param name="tests">the Number of Tests that will run</param>
+		virtual void suiteStart(size_t tests);
+
+		/// <summary>
+		/// A Test starts, only its Name may be read yet
+		/// </summary>
+		/// <param name="test">the Test</param>
+		virtual void testStart(const Testable& test);
+
+		/// <summary>
+		/// A Check of a running Test failed
+		/// </summary>
+		/// <param name="test">the Test, only its Name may be read yet</param>
+		/// <param name="code">the Code that was checked</param>
+		/// <param name="location">the File and Line of the Check</param>
+		/// <param name="values">the formatted Values or nullptr</param>
+		virtual void assertionFailed(const Testable& test, const char* code, const SourceLocation& location, const char* values);
+
+		/// <summary>
+		/// A Test finished
+		/// </summary>
+		/// <param name="test">the Test</param>
+		virtual void testEnd(const Testable& test);
+
+		/// <summary>
+		/// The Run finished
+		/// </summary>
+		/// <param name="summary">the Totals of the Run</param>
+		virtual void suiteEnd(const RunSummary& summary);
+	};
+
+	/// <summary>
+	/// Writes the human readable Report, one Block per Test as it finishes
+	/// </summary>
+	class TextReporter : public Reporter {
+	private:	//private Members
+		std::ofstream mFile;
+		std::ostream& mStream;
+		bool mColor;
+
+	public:		//Constructors and Destructors
+		/// <summary>
+		/// Creates a Reporter writing to a Stream
+		/// </summary>
+		/// <param name="stream">the Stream to write to</param>
+		/// <param name="color">true to use ANSI Colors</param>
+		TextReporter(std::ostream& stream, bool color = false);
+
+		/// <summary>
+		/// Creates a Reporter writing to a File
+		/// </summary>
+		/// <param name="path">the File to write</param>
+		explicit TextReporter(const std::string& path);
+
+		TextReporter(const TextReporter&) = delete;
+
+	public:		//Events
+		void suiteStart(size_t tests) override;
+		void testEnd(const Testable& test) override;
+		void suiteEnd(const RunSummary& summary) override;
+	};
+
+}
+
+#endif
@@ -0,0 +1,99 @@
+#include "RunContext.h"
+#include "Testable.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Test {
+
+	/// <summary>
+	/// Adds the Outcome of one Iteration
+	/// </summary>
+	/// <param name="duration">the Duration in Milliseconds</param>
+	/// <param name="failed">true when the Test failed</param>
+	void TestStatistics::add(double duration, bool failed) {
+		mRuns++;
+		if (failed) mFailures++;
+
+		mMin = mRuns == 1 ? duration : std::min(mMin, duration);
+		mMax = mRuns == 1 ? duration : std::max(mMax, duration);
+
+		//welford: numerically stable without keeping the samples
+		double delta = duration - mMean;
+		mMean += delta / static_cast<double>(mRuns);
+		mSquares += delta * (duration - mMean);
+	}
+
+	/// <summary>
+	/// Returns the Number of Iterations the Test ran in
+	/// </summary>
+	/// <returns>the Number of Iterations</returns>
+	uint64_t TestStatistics::getRuns() const {
+		return mRuns;
+	}
+
+	/// <summary>
+	/// Returns the Number of Iterations the Test failed in
+	/// </summary>
+	/// <returns>the Number of Failures</returns>
+	uint64_t TestStatistics::getFailures() const {
+		return mFailures;
+	}
+
+	/// <summary>
+	/// returns weather the Test both passed and failed
+	/// </summary>
+	/// <returns>true when the Outcome changed between Iterations</returns>
+	bool TestStatistics::isFlaky() const {
+		return mFailures > 0 && mFailures < mRuns;
+	}
+
+	/// <summary>
+	/// Returns the mean Duration
+	/// </summary>
+	/// <returns>the Duration in Milliseconds</returns>
+	double TestStatistics::getMean() const {
+		return mMean;
+	}
+
+	/// <summary>
+	/// Returns the Standard Deviation of the Durations
+	/// </summary>
+	/// <returns>the Standard Deviation in Milliseconds, 0 for a single Run</returns>
+	double TestStatistics::getStdDev() const {
+		if (mRuns < 2) return 0;
+		return std::sqrt(mSquares / static_cast<double>(mRuns - 1));
+	}
+
+	/// <summary>
+	/// Returns the shortest Duration
+	/// </summary>
+	/// <returns>the Duration in Milliseconds</returns>
+	double TestStatistics::getMin() const {
+		return mMin;
+	}
+
+	/// <summary>
+	/// Returns the longest Duration
+	/// </summary>
+	/// <returns>the Duration in Milliseconds</returns>
+	double TestStatistics::getMax() const {
+		return mMax;
+	}
+
+	/// <summary>
+	/// Destroys the Copies of a stressed Test
+	/// </summary>
+	RunContext::~RunContext() {
+		dropCopies();
+	}
+
+	/// <summary>
+	/// Destroys the Copies of a stressed Test, except those
+	/// abandoned on a Worker that may still run them
+	/// </summary>
+	void RunContext::dropCopies() {
+		for (auto test : mCopies)
+			if (!test->isAbandoned()) delete test;
+		mCopies.clear();
+	}
+}
@@ -0,0 +1,128 @@
+#pragma once
+#ifndef UT_RUN_CONTEXT_H
+#define UT_RUN_CONTEXT_H
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include "Reporter.h"
+
+namespace Test {
+
+	class Testable;
+	class TestCase;
+	class FixtureBase;
+
+	/// <summary>
+	/// Outcomes of a Test over the Iterations of a repeated Run. The Durations
+	/// are summarized with Welford's Algorithm, so the Memory doesn't grow with
+	/// the Number of Iterations.
+	/// </summary>
+	class TestStatistics {
+	private:	//private Members
+		uint64_t mRuns = 0;
+		uint64_t mFailures = 0;
+		double mMean = 0;
+		double mSquares = 0;
+		double mMin = 0;
+		double mMax = 0;
+
+	public:		//exposed Functionality
+		/// <summary>
+		/// Adds the Outcome of one Iteration
+		/// </summary>
+		/// <param name="duration">the Duration in Milliseconds</param>
+		/// <param name="failed">true when the Test failed</param>
+		void add(double duration, bool failed);
+
+	public:		//getters and setters
+		/// <summary>
+		/// Returns the Number of Iterations the Test ran in
+		/// </summary>
+		/// <returns>the Number of Iterations</returns>
+		uint64_t getRuns() const;
+
+		/// <summary>
+		/// Returns the Number of Iterations the Test failed in
+		/// </summary>
+		/// <returns>the Number of Failures</returns>
+		uint64_t getFailures() const;
+
+		/// <summary>
+		/// returns weather the Test both passed and failed
+		/// </summary>
+		/// <returns>true when the Outcome changed between Iterations</returns>
+		bool isFlaky() const;
+
+		/// <summary>
+		/// Returns the mean Duration
+		/// </summary>
+		/// <returns>the Duration in Milliseconds</returns>
+		double getMean() const;
+
+		/// <summary>
+		/// Returns the Standard Deviation of the Durations
+		/// </summary>
+		/// <returns>the Standard Deviation in Milliseconds, 0 for a single Run</returns>
+		double getStdDev() const;
+
+		/// <summary>
+		/// Returns the shortest Duration
+		/// </summary>
+		/// <returns>the Duration in Milliseconds</returns>
+		double getMin() const;
+
+		/// <summary>
+		/// Returns the longest Duration
+		/// </summary>
+		/// <returns>the Duration in Milliseconds</returns>
+		double getMax() const;
+	};
+
+	/// <summary>
+	/// State of a single Call of TestCollection::runTests, separate from the
+	/// registered Tests: the selected Tests, the Counters of the current
+	/// Iteration and the Statistics over all Iterations.
+	/// </summary>
+	struct RunContext {
+		//selected once per run
+		std::vector<Testable*> mTests;
+		std::vector<TestCase*> mCases;
+		uint64_t mDeselected = 0;
+		uint64_t mSeed = 0;
+
+		//instances of a stressed test case, owned by the run
+		std::vector<Testable*> mCopies;
+
+		//reset every iteration
+		std::vector<FixtureBase*> mFixtures;
+		std::atomic<uint64_t> mFailCount{ 0 };
+		std::atomic<uint64_t> mPassCount{ 0 };
+		std::atomic<uint64_t> mRegressedCount{ 0 };
+		std::atomic<uint64_t> mFlakyCount{ 0 };
+		RunSummary mSummary;
+
+		//over all iterations, one entry per test
+		std::map<std::string, TestStatistics> mStatistics;
+		uint64_t mIterations = 0;
+
+		RunContext() = default;
+		RunContext(const RunContext&) = delete;
+
+		/// <summary>
+		/// Destroys the Copies of a stressed Test
+		/// </summary>
+		~RunContext();
+
+		/// <summary>
+		/// Destroys the Copies of a stressed Test, except those
+		/// abandoned on a Worker that may still run them
+		/// </summary>
+		void dropCopies();
+	};
+
+}
+
+#endif
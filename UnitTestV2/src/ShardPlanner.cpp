@@ -0,0 +1,80 @@
+#include "ShardPlanner.h"
+#include <algorithm>
+#include <numeric>
+
+namespace Test {
+
+	/// <summary>
+	/// Assigns every Test to a Shard
+	/// </summary>
+	/// <param name="names">the Names of all Tests</param>
+	/// <param name="history">the Durations of earlier Runs in Milliseconds</param>
+	/// <param name="count">the Number of Shards</param>
+	/// <returns>the Shard of every Test, in the Order of the Names</returns>
+	std::vector<size_t> ShardPlanner::assign(const std::vector<std::string>& names, const TimingDatabase& history, size_t count) {
+		std::vector<size_t> shards(names.size(), 0);
+		if (count <= 1) return shards;
+
+		std::vector<double> durations = estimate(names, history);
+		if (durations.empty()) {
+			for (size_t i = 0; i < names.size(); i++)
+				shards[i] = static_cast<size_t>(hash(names[i]) % count);
+			return shards;
+		}
+
+		//longest first, names break ties so the order is the same everywhere
+		std::vector<size_t> order(names.size());
+		std::iota(order.begin(), order.end(), size_t(0));
+		std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+			if (durations[a] != durations[b]) return durations[a] > durations[b];
+			return names[a] < names[b];
+		});
+
+		//min_element picks the lowest index among equally loaded shards
+		std::vector<double> loads(count, 0.0);
+		for (size_t index : order) {
+			size_t shard = static_cast<size_t>(std::min_element(loads.begin(), loads.end()) - loads.begin());
+			shards[index] = shard;
+			loads[shard] += durations[index];
+		}
+		return shards;
+	}
+
+	/// <summary>
+	/// Estimates the Duration of every Test
+	/// </summary>
+	/// <param name="names">the Names of all Tests</param>
+	/// <param name="history">the Durations of earlier Runs in Milliseconds</param>
+	/// <returns>the estimated Durations, empty when no Test has History</returns>
+	std::vector<double> ShardPlanner::estimate(const std::vector<std::string>& names, const TimingDatabase& history) {
+		std::vector<double> durations(names.size(), -1.0);
+		std::vector<double> known;
+		for (size_t i = 0; i < names.size(); i++) {
+			const Timing* timing = history.find(names[i]);
+			if (!timing) continue;
+			durations[i] = timing->mMean;
+			known.push_back(timing->mMean);
+		}
+		if (known.empty()) return std::vector<double>();
+
+		std::nth_element(known.begin(), known.begin() + known.size() / 2, known.end());
+		double median = known[known.size() / 2];
+		for (auto& duration : durations)
+			if (duration < 0) duration = median;
+		return durations;
+	}
+
+	/// <summary>
+	/// returns the FNV-1a Hash of a Name, the same on every Platform
+	/// </summary>
+	/// <param name="name">the Name to hash</param>
+	/// <returns>the 64 bit Hash</returns>
+	uint64_t ShardPlanner::hash(const std::string& name) {
+		uint64_t result = 14695981039346656037ull;
+		for (unsigned char c : name) {
+			result ^= c;
+			result *= 1099511628211ull;
+		}
+		return result;
+	}
+}
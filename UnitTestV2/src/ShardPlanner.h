@@ -0,0 +1,50 @@
+#pragma once
+#ifndef UT_SHARD_PLANNER_H
+#define UT_SHARD_PLANNER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "TimingDatabase.h"
+
+namespace Test {
+
+	/// <summary>
+	/// Splits the Tests into Shards that run on separate Machines.
+	/// With recorded Durations the Tests are bin packed longest first onto
+	/// the least loaded Shard, so all Shards finish at about the same Time.
+	/// Without any History every Test goes to the Shard picked by the Hash of
+	/// its Name. The Assignment only depends on the Names and the History, so
+	/// every Machine computes the same Split as long as they share the History.
+	/// </summary>
+	class ShardPlanner {
+	public:		//exposed Functionality
+		/// <summary>
+		/// Assigns every Test to a Shard
+		/// </summary>
+		/// <param name="names">the Names of all Tests</param>
+		/// <param name="history">the Durations of earlier Runs in Milliseconds</param>
+		/// <param name="count">the Number of Shards</param>
+		/// <returns>the Shard of every Test, in the Order of the Names</returns>
+		static std::vector<size_t> assign(const std::vector<std::string>& names, const TimingDatabase& history, size_t count);
+
+		/// <summary>
+		/// Estimates the Duration of every Test. Tests without History are
+		/// expected to take as long as the median known Test.
+		/// </summary>
+		/// <param name="names">the Names of all Tests</param>
+		/// <param name="history">the Durations of earlier Runs in Milliseconds</param>
+		/// <returns>the estimated Durations, empty when no Test has History</returns>
+		static std::vector<double> estimate(const std::vector<std::string>& names, const TimingDatabase& history);
+
+		/// <summary>
+		/// returns the FNV-1a Hash of a Name, the same on every Platform
+		/// </summary>
+		/// <param name="name">the Name to hash</param>
+		/// <returns>the 64 bit Hash</returns>
+		static uint64_t hash(const std::string& name);
+	};
+
+}
+
+#endif
@@ -0,0 +1,91 @@
+#pragma once
+#ifndef UT_STRINGIFY_H
+#define UT_STRINGIFY_H
+
+#include <limits>
+#include <iterator>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace Test {
+
+	/// <summary>
+	/// Tells weather a Type can be written to a std::ostream
+	/// </summary>
+	/// <typeparam name="T">the Type</typeparam>
+	template<typename T, typename = void>
+	struct isStreamable : std::false_type {};
+
+	template<typename T>
+	struct isStreamable<T, std::void_t<decltype(std::declval<std::ostream&>() << std::declval<const T&>())>> : std::true_type {};
+
+	/// <summary>
+	/// Tells weather a Type is a Container that can be iterated
+	/// </summary>
+	/// <typeparam name="T">the Type</typeparam>
+	template<typename T, typename = void>
+	struct isRange : std::false_type {};
+
+	template<typename T>
+	struct isRange<T, std::void_t<decltype(std::begin(std::declval<const T&>()) != std::end(std::declval<const T&>()))>> : std::true_type {};
+
+	/// <summary>
+	/// Formats a Value for the Report. Only called when a Check failed,
+	/// so it may be slow. Types that can't be streamed print their Size.
+	/// </summary>
+	/// <typeparam name="T">the Type of the Value</typeparam>
+	/// <param name="value">the Value</param>
+	/// <returns>the formatted Value</returns>
+	template<typename T>
+	std::string stringify(const T& value) {
+		typedef std::decay_t<T> type;
+
+		if constexpr (std::is_same_v<type, bool>) {
+			return value ? "true" : "false";
+		} else if constexpr (std::is_same_v<type, std::nullptr_t>) {
+			return "nullptr";
+		} else if constexpr (std::is_same_v<type, char>) {
+			return std::string("'") + value + '\'';
+		} else if constexpr (std::is_same_v<type, signed char> || std::is_same_v<type, unsigned char>) {
+			//int8_t and uint8_t are numbers, not characters
+			return std::to_string(static_cast<int>(value));
+		} else if constexpr (std::is_array_v<T> && std::is_same_v<std::remove_cv_t<std::remove_extent_t<T>>, char>) {
+			return std::string("\"") + value + '"';
+		} else if constexpr (std::is_same_v<type, const char*> || std::is_same_v<type, char*>) {
+			if (!value) return "nullptr";
+			return std::string("\"") + value + '"';
+		} else if constexpr (std::is_constructible_v<std::string, const T&>) {
+			return '"' + std::string(value) + '"';
+		} else if constexpr (isStreamable<T>::value) {
+			std::ostringstream stream;
+			//floating point values print exactly, so values that differ in the last digit don't look equal
+			if constexpr (std::is_floating_point_v<type>)
+				stream.precision(std::numeric_limits<type>::max_digits10);
+			stream << value;
+			return stream.str();
+		} else if constexpr (isRange<T>::value) {
+			//long containers are cut off, the report is meant to be read
+			std::string text = "{";
+			size_t count = 0;
+			for (const auto& element : value) {
+				if (count > 0) text += ", ";
+				if (count++ == 32) {
+					text += "...";
+					break;
+				}
+				text += stringify(element);
+			}
+			return text + '}';
+		} else if constexpr (std::is_enum_v<type>) {
+			return std::to_string(static_cast<std::underlying_type_t<type>>(value));
+		} else {
+			return "{" + std::to_string(sizeof(T)) + " byte object}";
+		}
+	}
+
+}
+
+#endif
@@ -0,0 +1,173 @@
+#include "TestCase.h"
+#include "Testable.h"
+#include <sstream>
+
+namespace Test {
+
+	namespace {
+		//set while a descriptor constructs its test on this thread
+		thread_local bool tConstructing = false;
+	}
+
+	//both constant initialized, so descriptors can register in any order during startup
+	TestCase* TestCase::mFirst = nullptr;
+	TestCase** TestCase::mLast = &TestCase::mFirst;
+
+
+	/// <summary>
+	/// Registers the Descriptor, called while the Program starts
+	/// </summary>
+	/// <param name="name">the Name of the Test</param>
+	/// <param name="tags">the space separated Tags of the Test</param>
+	/// <param name="location">the File and Line of the Declaration</param>
+	/// <param name="create">constructs the Test</param>
+	/// <param name="timeout">the Time in Milliseconds the Test may take, 0 for no Limit</param>
+	/// <param name="sources">the space separated Source Files the Test exercises</param>
+	TestCase::TestCase(const char* name, const char* tags, const SourceLocation& location, factory create, double timeout, const char* sources)
+		: mName(name), mTags(tags), mLocation(&location), mFactory(create), mTimeout(timeout), mSources(sources) {
+		*mLast = this;
+		mLast = &mNext;
+	}
+
+	/// <summary>
+	/// Destroys the Test unless it was abandoned on a Worker
+	/// </summary>
+	TestCase::~TestCase() {
+		Testable* test = mTest.load();
+		if (test && !test->isAbandoned()) delete test;
+	}
+
+	/// <summary>
+	/// Constructs the Test without registering it with the TestCollection
+	/// </summary>
+	/// <returns>the Test, owned by the Descriptor</returns>
+	Testable* TestCase::construct() {
+		Testable* test = instantiate();
+		mTest.store(test, std::memory_order_release);
+		return test;
+	}
+
+	/// <summary>
+	/// Constructs another Instance of the Test, which the Descriptor doesn't keep
+	/// </summary>
+	/// <returns>the Test, owned by the Caller</returns>
+	Testable* TestCase::instantiate() const {
+		tConstructing = true;
+		Testable* test;
+		try {
+			test = mFactory();
+		} catch (...) {
+			tConstructing = false;
+			throw;
+		}
+		tConstructing = false;
+
+		for (const auto& tag : getTags())
+			test->tag(tag);
+		for (const auto& source : getSources())
+			test->covers(source);
+		if (mTimeout > 0) test->setTimeout(mTimeout);
+		return test;
+	}
+
+	/// <summary>
+	/// Moves the Descriptor out of Idle
+	/// </summary>
+	/// <param name="state">Claimed to construct and run the Test, Skipped to report it as not run</param>
+	/// <returns>false when another Thread claimed it before</returns>
+	bool TestCase::claim(State state) {
+		int expected = Idle;
+		return mState.compare_exchange_strong(expected, state);
+	}
+
+	/// <summary>
+	/// Moves the Descriptor back to Idle, so the Test runs again
+	/// </summary>
+	void TestCase::rearm() {
+		mState.store(Idle);
+	}
+
+	/// <summary>
+	/// returns weather the calling Thread is constructing a Test from a Descriptor
+	/// </summary>
+	/// <returns>true while a Descriptor constructs its Test</returns>
+	bool TestCase::isConstructing() {
+		return tConstructing;
+	}
+
+	/// <summary>
+	/// Returns the first registered Descriptor
+	/// </summary>
+	/// <returns>the Descriptor, nullptr when there is none</returns>
+	TestCase* TestCase::first() {
+		return mFirst;
+	}
+
+	/// <summary>
+	/// Returns the Descriptor registered after this one
+	/// </summary>
+	/// <returns>the Descriptor, nullptr for the last one</returns>
+	TestCase* TestCase::next() const {
+		return mNext;
+	}
+
+	/// <summary>
+	/// Getter for the Name of the Test
+	/// </summary>
+	/// <returns>the Name of the Test</returns>
+	const char* TestCase::getName() const {
+		return mName;
+	}
+
+	/// <summary>
+	/// Returns the Tags of the Test
+	/// </summary>
+	/// <returns>the Tags</returns>
+	std::vector<std::string> TestCase::getTags() const {
+		std::vector<std::string> tags;
+		std::istringstream stream(mTags);
+		std::string tag;
+		while (stream >> tag)
+			tags.push_back(tag);
+		return tags;
+	}
+
+	/// <summary>
+	/// Returns the Source Files the Test exercises, known before it is constructed
+	/// </summary>
+	/// <returns>the declared Files and the File declaring the Test</returns>
+	std::vector<std::string> TestCase::getSources() const {
+		std::vector<std::string> sources;
+		std::istringstream stream(mSources);
+		std::string source;
+		while (stream >> source)
+			sources.push_back(source);
+		//a change to the test itself reruns it as well
+		sources.push_back(mLocation->mFile);
+		return sources;
+	}
+
+	/// <summary>
+	/// Returns where the Test was declared
+	/// </summary>
+	/// <returns>the File and Line of the Declaration</returns>
+	const SourceLocation& TestCase::getLocation() const {
+		return *mLocation;
+	}
+
+	/// <summary>
+	/// Returns the Time the Test may take, known before it is constructed
+	/// </summary>
+	/// <returns>the Time in Milliseconds, 0 for no Limit</returns>
+	double TestCase::getTimeout() const {
+		return mTimeout;
+	}
+
+	/// <summary>
+	/// Returns the Test, once it was constructed
+	/// </summary>
+	/// <returns>the Test, nullptr before it was constructed</returns>
+	Testable* TestCase::getTest() const {
+		return mTest.load(std::memory_order_acquire);
+	}
+}
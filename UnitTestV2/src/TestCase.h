@@ -0,0 +1,190 @@
+#pragma once
+#ifndef UT_TEST_CASE_H
+#define UT_TEST_CASE_H
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include "utCommon.h"
+
+//declares a Test without instantiating it in main, followed by the Body of the Test.
+//Only a Descriptor is registered while the Program starts, the Test itself is
+//constructed on the Worker that runs it. Safe to use in Headers.
+#define TEST_CASE(type, name) TAGGED_TEST_CASE(type, name, "")
+
+//like TEST_CASE, with a space separated List of Tags, like "math slow"
+#define TAGGED_TEST_CASE(type, name, tags) TIMED_TEST_CASE(type, name, tags, 0)
+
+//like TAGGED_TEST_CASE, with the Time in Milliseconds the Test may take, 0 for no Limit.
+//The Body should check shouldStop in long Loops, see Testable::setTimeout.
+#define TIMED_TEST_CASE(type, name, tags, milliseconds) COVERING_TEST_CASE(type, name, tags, milliseconds, "")
+
+//like TIMED_TEST_CASE, with a space separated List of the Source Files the Test exercises,
+//like "src/math.cpp src/math.h". The File declaring the Test is always covered.
+#define COVERING_TEST_CASE(type, name, tags, milliseconds, sources) \
+	class type : public ::Test::Testable {\
+	public:\
+		type() : Testable(name) {}\
+	protected:\
+		void run() override;\
+	};\
+	inline ::Test::TestCase type##Case(name, tags, UT_LOCATION, &::Test::TestCase::create<type>, milliseconds, sources);\
+	inline void type::run()
+
+namespace Test {
+
+	class Testable;
+	class TestCollection;
+
+	/// <summary>
+	/// Descriptor of a Test declared with TEST_CASE. The Descriptors form an
+	/// intrusive List in Order of Registration, so registering a Test costs two
+	/// Pointer Stores and no Allocation. The Test is constructed on the Worker
+	/// that runs it and owned by the Descriptor afterwards.
+	/// </summary>
+	class TestCase {
+		friend TestCollection;
+	public:		//definitions
+		typedef Testable* (*factory)();
+
+	private:	//internal Defines
+		/// <summary>
+		/// Progress of the Descriptor, only the Thread that moves it
+		/// out of Idle constructs the Test
+		/// </summary>
+		enum State {
+			Idle,
+			Claimed,
+			Skipped
+		};
+
+	private:	//private Members
+		static TestCase* mFirst;
+		static TestCase** mLast;
+
+		const char* mName;
+		const char* mTags;
+		const SourceLocation* mLocation;
+		factory mFactory;
+		double mTimeout;
+		const char* mSources;
+		TestCase* mNext = nullptr;
+
+		std::atomic<int> mState{ Idle };
+		std::atomic<Testable*> mTest{ nullptr };
+
+	public:		//Constructors and Destructors
+		/// <summary>
+		/// Registers the Descriptor, called while the Program starts
+		/// </summary>
+		/// <param name="name">the Name of the Test</param>
+		/// <param name="tags">the space separated Tags of the Test</param>
+		/// <param name="location">the File and Line of the Declaration</param>
+		/// <param name="create">constructs the Test</param>
+		/// <param name="timeout">the Time in Milliseconds the Test may take, 0 for no Limit</param>
+		/// <param name="sources">the space separated Source Files the Test exercises</param>
+		TestCase(const char* name, const char* tags, const SourceLocation& location, factory create, double timeout = 0, const char* sources = "");
+
+		TestCase(const TestCase&) = delete;
+
+		/// <summary>
+		/// Destroys the Test unless it was abandoned on a Worker
+		/// </summary>
+		~TestCase();
+
+	private:	//internal functionality
+		/// <summary>
+		/// Constructs the Test without registering it with the TestCollection
+		/// </summary>
+		/// <returns>the Test, owned by the Descriptor</returns>
+		Testable* construct();
+
+		/// <summary>
+		/// Constructs another Instance of the Test, which the Descriptor doesn't keep
+		/// </summary>
+		/// <returns>the Test, owned by the Caller</returns>
+		Testable* instantiate() const;
+
+		/// <summary>
+		/// Moves the Descriptor out of Idle
+		/// </summary>
+		/// <param name="state">Claimed to construct and run the Test, Skipped to report it as not run</param>
+		/// <returns>false when another Thread claimed it before</returns>
+		bool claim(State state);
+
+		/// <summary>
+		/// Moves the Descriptor back to Idle, so the Test runs again
+		/// </summary>
+		void rearm();
+
+	public:		//exposed Functionality
+		/// <summary>
+		/// Constructs a Test of Type T, used as the Factory of TEST_CASE
+		/// </summary>
+		/// <typeparam name="T">the Type of the Test</typeparam>
+		/// <returns>the new Test</returns>
+		template<typename T>
+		static Testable* create() {
+			return new T();
+		}
+
+		/// <summary>
+		/// returns weather the calling Thread is constructing a Test from a Descriptor,
+		/// such Tests are not registered by the Testable Constructor
+		/// </summary>
+		/// <returns>true while a Descriptor constructs its Test</returns>
+		static bool isConstructing();
+
+		/// <summary>
+		/// Returns the first registered Descriptor
+		/// </summary>
+		/// <returns>the Descriptor, nullptr when there is none</returns>
+		static TestCase* first();
+
+	public:		//getters and setters
+		/// <summary>
+		/// Returns the Descriptor registered after this one
+		/// </summary>
+		/// <returns>the Descriptor, nullptr for the last one</returns>
+		TestCase* next() const;
+
+		/// <summary>
+		/// Getter for the Name of the Test
+		/// </summary>
+		/// <returns>the Name of the Test</returns>
+		const char* getName() const;
+
+		/// <summary>
+		/// Returns the Tags of the Test
+		/// </summary>
+		/// <returns>the Tags</returns>
+		std::vector<std::string> getTags() const;
+
+		/// <summary>
+		/// Returns the Source Files the Test exercises, known before it is constructed
+		/// </summary>
+		/// <returns>the declared Files and the File declaring the Test</returns>
+		std::vector<std::string> getSources() const;
+
+		/// <summary>
+		/// Returns where the Test was declared
+		/// </summary>
+		/// <returns>the File and Line of the Declaration</returns>
+		const SourceLocation& getLocation() const;
+
+		/// <summary>
+		/// Returns the Time the Test may take, known before it is constructed
+		/// </summary>
+		/// <returns>the Time in Milliseconds, 0 for no Limit</returns>
+		double getTimeout() const;
+
+		/// <summary>
+		/// Returns the Test, once it was constructed
+		/// </summary>
+		/// <returns>the Test, nullptr before it was constructed</returns>
+		Testable* getTest() const;
+	};
+
+}
+
+#endif
@@ -1,14 +1,39 @@
 #include "TestCollection.h"
+#include "ThreadPool.h"
+#include "ProcessRunner.h"
+#include "ShardPlanner.h"
+#include "Watchdog.h"
+#include "ReportQueue.h"
+#include "OutputCapture.h"
+#include "Generators.h"
+#include <fstream>
 #include <iomanip>
-#include <vector>
-#include <thread>
 #include <map>
 #include <chrono>
+#include <cstdlib>
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
 
 namespace Test {
-	// initialize the Instance pointer to nullptr
-	TestCollection* TestCollection::mInstance = nullptr;
+	namespace {
+		/// <summary>
+		/// returns the first Failure of a Test, to report it after a Retry replaced it
+		/// </summary>
+		/// <param name="results">the Results of the failed Attempt</param>
+		/// <returns>the Error, or the Code and Location of the first Fail</returns>
+		std::string describeFailure(const TestResultCollection& results) {
+			if (results.hasError()) return results.getError();
 
+			std::string failure;
+			results.forEach([&failure](const char* code, const SourceLocation& location, const char*) {
+				if (failure.empty()) failure = std::string(code) + " at " + location.mFile + ':' + std::to_string(location.mLine);
+			});
+			return failure;
+		}
+	}
 
 	/// <summary>
 	/// Instantly reports an Error in one of the Tests caused by the Framework.
@@ -24,9 +49,9 @@ namespace Test {
 	/// </summary>
 	/// <returns>a Reference to the instance of the TestCollection</returns>
 	TestCollection& TestCollection::Instance() {
-		if (mInstance == nullptr)
-			mInstance = new TestCollection();
-		return *mInstance;
+		//initialized thread safe on first use and destroyed at exit
+		static TestCollection instance;
+		return instance;
 	}
 
 	/// <summary>
@@ -38,112 +63,1007 @@ namespace Test {
 	}
 
 	/// <summary>
-	/// Runs all the Tests
+	/// Runs a single Test and records its Outcome. A failed Test is
+	/// run again, up to the Number of Retries.
 	/// </summary>
-	void TestCollection::runTests() {
+	/// <param name="test">the Test to run</param>
+	void TestCollection::runTest(Testable* test) {
+		//fixtures are built outside of the time and the timeout of the test
+		for (auto fixture : test->mFixtures) {
+			if (fixture->acquire()) continue;
+			test->mResult.error("Fixture " + fixture->getName() + " failed: " + fixture->getError());
+			releaseFixtures(test);
+			return;
+		}
+
+		//the fixtures stay for all attempts, a retry shouldn't rebuild shared state
+		uint32_t retries = Instance().mRetries;
+		std::string cause;
+		uint32_t attempt = 1;
+		for (;; attempt++) {
+			runAttempt(test);
+
+			//a timeout would only cost the time again, and a stopped test is given up on
+			if (!test->hasFailed() || attempt > retries) break;
+			if (test->mResult.hasTimedOut() || test->shouldStop()) break;
+
+			if (cause.empty()) cause = describeFailure(test->mResult);
+			test->reset();
+		}
+		if (attempt > 1) test->mResult.retried(attempt, cause);
+
+		releaseFixtures(test);
+	}
+
+	/// <summary>
+	/// Runs a single Attempt of a Test, with its Watchdog and Counters
+	/// </summary>
+	/// <param name="test">the Test to run</param>
+	void TestCollection::runAttempt(Testable* test) {
+		//the watchdog of an abandoned pool is leaked with it, so the pointer stays valid
+		Watchdog* watchdog = Instance().mWatchdog.load(std::memory_order_acquire);
+		bool watched = watchdog && test->mTimeout > 0;
+		if (watched) watchdog->arm(test, test->mTimeout);
+
+		try {
+			PerfCounters counters;
+			bool counting = Instance().mPerfCounters && counters.start();
+			AllocationTracker::Statistics allocations = AllocationTracker::begin();
+
+			if (test->_init()) {
+				test->_run();
+				test->_cleanup();
+
+				test->mAllocations = AllocationTracker::end(allocations);
+				if (counting) test->mCounters = counters.stop();
+
+				//also catches tests that ignored shouldStop and finished late
+				if (test->mTimeout > 0 && test->getTime().count() >= test->mTimeout)
+					test->mResult.timeout(test->mTimeout);
+			}
+		}
+		catch (std::exception& e) {
+			Instance().error(e.what());
+		}
+		catch (...) {
+			Instance().error("unexpected error");
+		}
+
+		if (watched) watchdog->disarm(test);
+	}
+
+	/// <summary>
+	/// Tells the Fixtures of a Test that it finished
+	/// </summary>
+	/// <param name="test">the finished Test</param>
+	void TestCollection::releaseFixtures(Testable* test) {
+		for (auto fixture : test->mFixtures)
+			fixture->release();
+	}
+
+	/// <summary>
+	/// Runs a Test on a Worker Thread unless the global Timeout gave up on it before
+	/// </summary>
+	/// <param name="test">the Test to run</param>
+	void TestCollection::runClaimed(Testable* test) {
+		int expected = Testable::Idle;
+		if (!test->mState.compare_exchange_strong(expected, Testable::Running)) return;
+
+		ReportQueue::testStart(test);
+		runTest(test);
+
+		//an abandoned test is already counted as failed
+		expected = Testable::Running;
+		if (test->mState.compare_exchange_strong(expected, Testable::Done)) complete(test);
+	}
+
+	/// <summary>
+	/// Constructs the Test of a TEST_CASE and applies the Settings of the Run
+	/// </summary>
+	/// <param name="testCase">the Descriptor of the Test</param>
+	/// <returns>the Test</returns>
+	Testable* TestCollection::materialize(TestCase* testCase) {
+		//constructed once, later runs reuse it
+		Testable* test = testCase->getTest();
+		if (test) return test;
+
+		test = testCase->construct();
+		if (Instance().mFailLimit > 0 && test->getFailLimit() == 0) test->setFailLimit(Instance().mFailLimit);
+		return test;
+	}
+
+	/// <summary>
+	/// Constructs and runs the Test of a TEST_CASE on a Worker Thread,
+	/// unless the global Timeout gave up on it before
+	/// </summary>
+	/// <param name="testCase">the Descriptor of the Test</param>
+	void TestCollection::runCase(TestCase* testCase) {
+		if (!testCase->claim(TestCase::Claimed)) return;
+		runClaimed(materialize(testCase));
+	}
+
+	/// <summary>
+	/// Runs Tests on a Pool of Worker Threads until they are done or the Deadline passed
+	/// </summary>
+	/// <param name="entries">the Tests and TEST_CASEs to run, in the Order they are started in</param>
+	/// <param name="threads">the Number of Threads, 0 uses one per hardware Thread</param>
+	/// <param name="deadline">the global Deadline</param>
+	/// <param name="workers">receives the Number of Threads used</param>
+	/// <returns>false when the Deadline passed and the Pool was abandoned</returns>
+	bool TestCollection::runOnPool(const std::vector<Dispatch>& entries, size_t threads, std::chrono::steady_clock::time_point deadline, size_t& workers) {
+		std::unique_ptr<ThreadPool> pool(new ThreadPool(threads));
+		workers = pool->size();
+
+		//submitted in dispatch order, so idle workers take the longest remaining entry next
+		std::vector<Testable*> tests;
+		std::vector<TestCase*> cases;
+		for (const Dispatch& entry : entries) {
+			if (Testable* test = entry.mTest) {
+				tests.push_back(test);
+				pool->submit([test]()->void { runClaimed(test); });
+			} else {
+				TestCase* testCase = entry.mCase;
+				cases.push_back(testCase);
+				pool->submit([testCase]()->void { runCase(testCase); });
+			}
+		}
+
+		if (pool->waitUntil(deadline)) return true;
+
+		giveUp(tests, cases);
+		//hung tests still run on the workers, so the pool has to outlive them
+		pool.release()->abandon();
+		return false;
+	}
+
+	/// <summary>
+	/// Fails all Tests that did not finish before the global Timeout
+	/// </summary>
+	/// <param name="tests">the Tests to check</param>
+	/// <param name="cases">the TEST_CASEs to check</param>
+	void TestCollection::giveUp(const std::vector<Testable*>& tests, const std::vector<TestCase*>& cases) {
+		std::vector<Testable*> pending(tests);
+		for (auto testCase : cases) {
+			//an unclaimed test is only constructed to be reported as not run
+			if (testCase->claim(TestCase::Skipped)) pending.push_back(materialize(testCase));
+			else if (Testable* test = testCase->getTest()) pending.push_back(test);
+		}
+
+		for (auto test : pending) {
+			int expected = Testable::Idle;
+			if (test->mState.compare_exchange_strong(expected, Testable::Skipped)) {
+				test->mResult.error("Not run, the global Timeout expired");
+				releaseFixtures(test);
+				complete(test);
+				continue;
+			}
+
+			expected = Testable::Running;
+			if (test->mState.compare_exchange_strong(expected, Testable::Abandoned)) {
+				test->mStop.store(true, std::memory_order_relaxed);
+				Instance().mRun.mFailCount.fetch_add(1, std::memory_order_relaxed);
+				ReportQueue::testEnd(test);
+			}
+		}
+	}
+
+	/// <summary>
+	/// Counts a finished Test as passed or failed
+	/// </summary>
+	/// <param name="test">the finished Test</param>
+	void TestCollection::record(Testable* test) {
+		//only the totals matter, so no ordering with the test results is needed
+		if (test->hasFailed()) Instance().mRun.mFailCount.fetch_add(1, std::memory_order_relaxed);
+		else Instance().mRun.mPassCount.fetch_add(1, std::memory_order_relaxed);
+		if (test->mResult.isFlaky()) Instance().mRun.mFlakyCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	/// <summary>
+	/// Compares the Timing of a finished Test against the Baseline
+	/// </summary>
+	/// <param name="test">the finished Test</param>
+	void TestCollection::checkRegression(Testable* test) {
+		TestCollection& instance = Instance();
+
+		test->mBaseline = instance.mBaseline.find(std::string(test->getName()));
+		test->mRegressed = test->mFinished && test->mBaseline && TimingDatabase::isRegression(
+			test->getTiming(), *test->mBaseline, instance.mTolerance, instance.mMinimumRegression);
+
+		if (test->mRegressed) instance.mRun.mRegressedCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	/// <summary>
+	/// Records the Outcome of a finished Test and hands it to the Reporters
+	/// </summary>
+	/// <param name="test">the finished Test</param>
+	void TestCollection::complete(Testable* test) {
+		record(test);
+		checkRegression(test);
+		ReportQueue::testEnd(test);
+	}
+
+	/// <summary>
+	/// Sets the Number of Worker Threads used to run the Tests
+	/// </summary>
+	/// <param name="threads">the Number of Threads, 0 uses one per hardware Thread</param>
+	void TestCollection::setThreadCount(size_t threads) {
+		Instance().mThreadCount = threads;
+	}
+
+	/// <summary>
+	/// Drops all Tests the Filter doesn't select
+	/// </summary>
+	void TestCollection::selectTests() {
+		TestCollection& instance = Instance();
+		RunContext& run = instance.mRun;
+		run.mTests.clear();
+		run.mCases.clear();
+		run.mDeselected = 0;
+
+		//the registry stays untouched, so the next run can select differently
+		for (auto test : instance.mTests) {
+			if (instance.mFilter.matches(*test)) run.mTests.push_back(test);
+			else run.mDeselected++;
+		}
+
+		//test cases are selected by their descriptor, without constructing them
+		for (TestCase* testCase = TestCase::first(); testCase; testCase = testCase->next()) {
+			if (instance.mFilter.matches(testCase->getName(), testCase->getTags(), testCase->getSources())) {
+				testCase->rearm();
+				run.mCases.push_back(testCase);
+			} else {
+				run.mDeselected++;
+			}
+		}
+	}
+
+	/// <summary>
+	/// Drops all Tests that belong to other Shards
+	/// </summary>
+	void TestCollection::selectShard() {
+		TestCollection& instance = Instance();
+		RunContext& run = instance.mRun;
+		if (instance.mShardCount <= 1) return;
+
+		std::vector<std::string> names;
+		for (auto test : run.mTests)
+			names.emplace_back(test->getName());
+		for (auto testCase : run.mCases)
+			names.push_back(testCase->getName());
+		std::vector<size_t> shards = ShardPlanner::assign(names, instance.mHistory, instance.mShardCount);
+
+		size_t index = 0;
+		std::vector<Testable*> tests;
+		for (auto test : run.mTests)
+			if (shards[index++] == instance.mShardIndex) tests.push_back(test);
+		run.mTests.swap(tests);
+
+		std::vector<TestCase*> cases;
+		for (auto testCase : run.mCases)
+			if (shards[index++] == instance.mShardIndex) cases.push_back(testCase);
+		run.mCases.swap(cases);
+	}
+
+	/// <summary>
+	/// Selects one Copy of the stressed TEST_CASE per Worker Thread instead of the Tests
+	/// </summary>
+	void TestCollection::selectStress() {
+		TestCollection& instance = Instance();
+		RunContext& run = instance.mRun;
+
+		TestCase* stressed = nullptr;
+		for (TestCase* testCase = TestCase::first(); testCase; testCase = testCase->next())
+			if (instance.mStress == testCase->getName()) stressed = testCase;
+
+		run.mTests.clear();
+		run.mCases.clear();
+		run.mDeselected = instance.mTests.size();
+		for (TestCase* testCase = TestCase::first(); testCase; testCase = testCase->next())
+			if (testCase != stressed) run.mDeselected++;
+		if (!stressed) return;
+
+		//one copy per worker, so all of them run at the same time
+		size_t copies = instance.mThreadCount > 0 ? instance.mThreadCount : ThreadPool::defaultSize();
+		for (size_t i = 0; i < copies; i++) {
+			Testable* test = stressed->instantiate();
+			test->mName += '#' + std::to_string(i + 1);
+			if (instance.mFailLimit > 0 && test->getFailLimit() == 0) test->setFailLimit(instance.mFailLimit);
+			run.mCopies.push_back(test);
+			run.mTests.push_back(test);
+		}
+	}
+
+	/// <summary>
+	/// returns weather the Tests run in forked Worker Processes
+	/// </summary>
+	/// <returns>true when a Process Count is set and Processes are supported</returns>
+	bool TestCollection::isIsolated() {
+		//copies of a stressed test have to share their process to race
+		TestCollection& instance = Instance();
+		return instance.mProcessCount > 0 && instance.mStress.empty() && ProcessRunner::isSupported();
+	}
+
+	/// <summary>
+	/// Counts the Tests of this Run using each Fixture,
+	/// so the last of them can tear it down
+	/// </summary>
+	void TestCollection::prepareFixtures() {
+		RunContext& run = Instance().mRun;
+		run.mFixtures.clear();
+
+		for (auto test : run.mTests)
+			for (auto fixture : test->mFixtures)
+				fixture->mUsers = 0;
+
+		for (auto test : run.mTests)
+			for (auto fixture : test->mFixtures)
+				if (fixture->mUsers++ == 0) run.mFixtures.push_back(fixture);
+
+		for (auto fixture : run.mFixtures) {
+			fixture->mPending.store(fixture->mUsers);
+			fixture->mBuildTime = 0;
+			fixture->mError.clear();
+		}
+	}
+
+	/// <summary>
+	/// returns the Order Tests are dispatched in: longest first by
+	/// the loaded History, in Order of Registration when there is none
+	/// </summary>
+	/// <param name="names">the Names of the Tests</param>
+	/// <returns>the Indices of the Tests in Dispatch Order</returns>
+	std::vector<size_t> TestCollection::longestFirst(const std::vector<std::string>& names) {
+		std::vector<size_t> order(names.size());
+		std::iota(order.begin(), order.end(), size_t(0));
+
+		std::vector<double> durations = ShardPlanner::estimate(names, Instance().mHistory);
+		if (!durations.empty())
+			std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return durations[a] > durations[b]; });
+		return order;
+	}
+
+	/// <summary>
+	/// returns the Order Tests are dispatched in: shuffled by the Seed of the
+	/// Run and the Iteration when shuffling, otherwise longest first
+	/// </summary>
+	/// <param name="names">the Names of the Tests</param>
+	/// <returns>the Indices of the Tests in Dispatch Order</returns>
+	std::vector<size_t> TestCollection::arrange(const std::vector<std::string>& names) {
+		const RunContext& run = Instance().mRun;
+		if (run.mSeed == 0) return longestFirst(names);
+
+		std::vector<size_t> order(names.size());
+		std::iota(order.begin(), order.end(), size_t(0));
+
+		//fisher-yates with the platform independent engine, a seed replays the same order everywhere
+		Random random(run.mSeed + run.mIterations * 0x9e3779b97f4a7c15ull);
+		for (size_t i = order.size(); i > 1; i--)
+			std::swap(order[i - 1], order[static_cast<size_t>(Generators::below(random, i - 1))]);
+		return order;
+	}
+
+	/// <summary>
+	/// returns the Tests and TEST_CASEs in the Order they are dispatched,
+	/// both arranged together so neither always starts last
+	/// </summary>
+	/// <returns>the Tests and Descriptors to run</returns>
+	std::vector<TestCollection::Dispatch> TestCollection::dispatchOrder() {
+		const RunContext& run = Instance().mRun;
+
+		std::vector<Dispatch> entries;
+		std::vector<std::string> names;
+		for (auto test : run.mTests) {
+			entries.push_back({ test, nullptr });
+			names.emplace_back(test->getName());
+		}
+		for (auto testCase : run.mCases) {
+			entries.push_back({ nullptr, testCase });
+			names.push_back(testCase->getName());
+		}
+
+		std::vector<Dispatch> result;
+		for (size_t index : arrange(names))
+			result.push_back(entries[index]);
+		return result;
+	}
+
+	/// <summary>
+	/// Runs the Tests in forked Worker Processes instead of Threads
+	/// </summary>
+	/// <param name="processes">the Number of Worker Processes, 0 runs the Tests in Threads</param>
+	void TestCollection::setProcessCount(size_t processes) {
+		Instance().mProcessCount = processes;
+	}
+
+	/// <summary>
+	/// Enables capturing Output written directly to the stdout File Descriptor
+	/// (printf, write) while the Tests run.
+	/// </summary>
+	/// <param name="capture">true to enable the Capture</param>
+	void TestCollection::setCaptureFileOutput(bool capture) {
+		Instance().mCaptureFileOutput = capture;
+	}
+
+	/// <summary>
+	/// Runs the selected Tests once and hands the Outcome to the Reporters
+	/// </summary>
+	/// <param name="iteration">the Number of the Iteration, starting at 1</param>
+	void TestCollection::runIteration(uint64_t iteration) {
+		TestCollection& instance = Instance();
+		RunContext& run = instance.mRun;
+		run.mFailCount.store(0);
+		run.mPassCount.store(0);
+		run.mRegressedCount.store(0);
+		run.mFlakyCount.store(0);
+		run.mIterations = iteration;
+		prepareFixtures();
+
+		OutputCapture::install();
+		if (instance.mCaptureFileOutput && !OutputCapture::beginFileCapture())
+			instance.error("failed to capture stdout file descriptor");
+
+		if (instance.mFailLimit > 0)
+			for (auto test : run.mTests)
+				if (test->getFailLimit() == 0) test->setFailLimit(instance.mFailLimit);
+
+		ReportQueue::start();
+		ReportQueue::suiteStart(run.mTests.size() + run.mCases.size());
+
+		//test cases are constructed on the workers, they never run exclusively
+		std::vector<Dispatch> parallel;
+		std::vector<Testable*> exclusive;
+		for (const Dispatch& entry : dispatchOrder()) {
+			if (entry.mTest && entry.mTest->isExclusive()) exclusive.push_back(entry.mTest);
+			else parallel.push_back(entry);
+		}
+		bool isolated = isIsolated();
+		size_t workers;
+
+		std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+		if (instance.mTimeout > 0)
+			deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration(instance.mTimeout));
+
+		//worker processes are killed instead, and a forked watchdog would have no thread
+		//test cases are constructed on the workers, their descriptors know the timeout up front
+		std::unique_ptr<Watchdog> watchdog;
+		if (!isolated) {
+			bool timed = std::any_of(run.mTests.begin(), run.mTests.end(), [](Testable* test) { return test->mTimeout > 0; })
+				|| std::any_of(run.mCases.begin(), run.mCases.end(), [](TestCase* testCase) { return testCase->getTimeout() > 0; });
+			if (timed) watchdog.reset(new Watchdog());
+		}
+		instance.mWatchdog.store(watchdog.get(), std::memory_order_release);
+
 		timepoint start = clock::now();
-		std::vector<std::thread> threads;
-
-		for (auto& test : Instance().mTests) {
-			threads.push_back(std::thread([&]()->void {
-				try {
-					if (!test->_init()) return;
-					test->_run();
-					test->_cleanup();
-
-					if (test->hasFailed()) Instance().mFailCount++;
-					else Instance().mPassCount++;
-				}
-				catch (std::exception& e) {
-					mInstance->error(e.what());
-				}
-				catch (...) {
-					mInstance->error("unexpected error");
-				}
-			}));
-		}
-
-		for (auto& thread : threads)
-			thread.join();
+		bool inTime = true;
+		if (isolated) {
+			//the test cases were constructed up front, only tests are left
+			std::vector<Testable*> tests;
+			for (const Dispatch& entry : parallel)
+				tests.push_back(entry.mTest);
+			ProcessRunner runner(tests);
+			runner.setDeadline(deadline);
+			runner.run(instance.mProcessCount);
+			workers = instance.mProcessCount;
+		} else {
+			inTime = runOnPool(parallel, instance.mThreadCount, deadline, workers);
+		}
+		timepoint middle = clock::now();
 
+		//exclusive tests (benchmarks) run alone, so nothing disturbs their timing
+		if (!inTime || std::chrono::steady_clock::now() >= deadline) {
+			giveUp(exclusive, std::vector<TestCase*>());
+		} else if (isolated) {
+			ProcessRunner runner(exclusive);
+			runner.setDeadline(deadline);
+			runner.run(1);
+		} else {
+			std::vector<Dispatch> entries;
+			for (auto test : exclusive)
+				entries.push_back({ test, nullptr });
+			size_t ignored;
+			inTime = runOnPool(entries, 1, deadline, ignored);
+		}
 		timepoint end = clock::now();
-		Instance().mDuration = end - start;
+
+		//abandoned tests still disarm the watchdog when they finish, it has to outlive them like the pool
+		instance.mWatchdog.store(nullptr, std::memory_order_release);
+		if (!inTime) watchdog.release();
+
+		RunSummary& summary = run.mSummary;
+		summary.mRawOutput.clear();
+		if (instance.mCaptureFileOutput)
+			summary.mRawOutput = OutputCapture::endFileCapture();
+		summary.mDuration = duration(end - start).count();
+
+		//tests constructed on the workers ran in parallel as well
+		std::vector<Testable*> ran;
+		for (const Dispatch& entry : parallel)
+			if (Testable* test = entry.mTest ? entry.mTest : entry.mCase->getTest()) ran.push_back(test);
+
+		//share of the worker time spent running tests, idle workers waiting on a long test lower it
+		summary.mEfficiency = -1;
+		workers = std::min(workers, ran.size());
+		duration wall = middle - start;
+		if (workers > 0 && wall.count() > 0) {
+			double busy = 0;
+			for (auto test : ran)
+				if (!test->isAbandoned()) busy += test->getTime().count();
+			summary.mEfficiency = busy / (wall.count() * workers);
+		}
+
+		summary.mFailed = run.mFailCount.load();
+		summary.mPassed = run.mPassCount.load();
+		summary.mRegressed = run.mRegressedCount.load();
+		summary.mFlaky = run.mFlakyCount.load();
+		summary.mHasBaseline = !instance.mBaseline.empty();
+		summary.mTimeout = instance.mTimeout;
+		summary.mShardIndex = instance.mShardIndex;
+		summary.mShardCount = instance.mShardCount;
+		summary.mDeselected = run.mDeselected;
+		summary.mIteration = instance.mRepeat > 1 || instance.mUntilFail ? iteration : 0;
+		summary.mSeed = run.mSeed;
+
+		summary.mFixtures.clear();
+		for (auto fixture : run.mFixtures) {
+			FixtureSummary entry;
+			entry.mName = fixture->getName();
+			entry.mUsers = fixture->mUsers;
+			entry.mBuildTime = fixture->getBuildTime();
+			entry.mError = fixture->getError();
+			summary.mFixtures.push_back(entry);
+		}
+
+		ReportQueue::suiteEnd(&summary);
+		ReportQueue::stop();
+
+		//one entry per test, so a soak run doesn't grow
+		for (auto test : ranTests())
+			if (!test->isAbandoned())
+				run.mStatistics[std::string(test->getName())].add(test->getTime().count(), test->hasFailed());
 	}
 
 	/// <summary>
-	/// writes a Report to the given ostream
+	/// Runs all the Tests on a Pool of Worker Threads or Processes
+	/// </summary>
+	void TestCollection::runTests() {
+		TestCollection& instance = Instance();
+		instance.mRun.mStatistics.clear();
+		instance.mRun.mIterations = 0;
+		instance.mRun.dropCopies();
+
+		instance.mRun.mSeed = 0;
+		if (instance.mShuffle) {
+			instance.mRun.mSeed = instance.mSeed;
+			std::random_device device;
+			while (instance.mRun.mSeed == 0)
+				instance.mRun.mSeed = (uint64_t(device()) << 32) | device();
+		}
+
+		//filtered first, so the shards split only the selected tests
+		if (!instance.mStress.empty()) {
+			selectStress();
+		} else {
+			selectTests();
+			selectShard();
+		}
+
+		//forked workers can't hand a test back, so the tests of test cases are constructed up front
+		if (isIsolated()) {
+			for (auto testCase : instance.mRun.mCases)
+				if (testCase->claim(TestCase::Claimed)) instance.mRun.mTests.push_back(materialize(testCase));
+			instance.mRun.mCases.clear();
+		}
+
+		uint64_t iterations = instance.mRepeat > 0 ? instance.mRepeat : instance.mUntilFail ? 0 : 1;
+		for (uint64_t iteration = 1;; iteration++) {
+			runIteration(iteration);
+
+			if (iterations != 0 && iteration >= iterations) break;
+			if (instance.mUntilFail && instance.mRun.mSummary.mFailed > 0) break;
+
+			//an abandoned test may still run, it can't be reset
+			std::vector<Testable*> tests = ranTests();
+			if (std::any_of(tests.begin(), tests.end(), [](Testable* test) { return test->isAbandoned(); })) break;
+
+			for (auto test : tests) {
+				test->reset();
+				test->rearm();
+			}
+			for (auto testCase : instance.mRun.mCases)
+				testCase->rearm();
+		}
+	}
+
+	/// <summary>
+	/// returns the Tests of the last Run, including the constructed TEST_CASEs
+	/// </summary>
+	/// <returns>the Tests</returns>
+	std::vector<Testable*> TestCollection::ranTests() {
+		RunContext& run = Instance().mRun;
+		std::vector<Testable*> tests(run.mTests);
+		for (auto testCase : run.mCases)
+			if (Testable* test = testCase->getTest()) tests.push_back(test);
+		return tests;
+	}
+
+	/// <summary>
+	/// Sets the Time the whole Run may take
+	/// </summary>
+	/// <param name="milliseconds">the Time in Milliseconds, 0 for no Limit</param>
+	void TestCollection::setTimeout(double milliseconds) {
+		Instance().mTimeout = milliseconds;
+	}
+
+	/// <summary>
+	/// Runs the Tests several Times in one Call of runTests
+	/// </summary>
+	/// <param name="count">the Number of Iterations, 0 for no Limit with untilFail</param>
+	/// <param name="untilFail">true to stop after the first Iteration in which a Test failed</param>
+	void TestCollection::setRepeat(uint64_t count, bool untilFail) {
+		Instance().mRepeat = count;
+		Instance().mUntilFail = untilFail;
+	}
+
+	/// <summary>
+	/// Runs a failed Test again, up to a Number of Times
+	/// </summary>
+	/// <param name="retries">the Number of Retries, 0 to report the first Failure</param>
+	void TestCollection::setRetries(uint32_t retries) {
+		Instance().mRetries = retries;
+	}
+
+	/// <summary>
+	/// Dispatches the Tests in a random Order instead of longest first
+	/// </summary>
+	/// <param name="shuffle">true to shuffle the Tests</param>
+	/// <param name="seed">the Seed, 0 for a new random Seed every Run</param>
+	void TestCollection::setShuffle(bool shuffle, uint64_t seed) {
+		Instance().mShuffle = shuffle;
+		Instance().mSeed = seed;
+	}
+
+	/// <summary>
+	/// Runs only a single TEST_CASE, as one Copy per Worker Thread at the same Time
+	/// </summary>
+	/// <param name="name">the Name of the TEST_CASE, empty to run the Tests normally</param>
+	/// <returns>false when there is no TEST_CASE with that Name</returns>
+	bool TestCollection::setStress(const std::string& name) {
+		if (!name.empty()) {
+			TestCase* testCase = TestCase::first();
+			while (testCase && name != testCase->getName())
+				testCase = testCase->next();
+			if (!testCase) return false;
+		}
+		Instance().mStress = name;
+		return true;
+	}
+
+	/// <summary>
+	/// Returns the Seed the Tests of the last Run were shuffled with
+	/// </summary>
+	/// <returns>the Seed, 0 when they weren't shuffled</returns>
+	uint64_t TestCollection::getSeed() {
+		return Instance().mRun.mSeed;
+	}
+
+	/// <summary>
+	/// Sets the Number of Fails stored per Test, for Tests that didn't set their own
+	/// </summary>
+	/// <param name="limit">the Number of Fails, 0 for no Limit</param>
+	void TestCollection::setFailLimit(uint64_t limit) {
+		Instance().mFailLimit = limit;
+	}
+
+	/// <summary>
+	/// Runs only one Shard of the Tests, so the Suite can be split across Machines
+	/// </summary>
+	/// <param name="index">the Shard to run, starting at 0</param>
+	/// <param name="count">the Number of Shards</param>
+	void TestCollection::setShard(size_t index, size_t count) {
+		Instance().mShardIndex = index;
+		Instance().mShardCount = count;
+	}
+
+	/// <summary>
+	/// Applies the Command Line Options of the Runner:
+	/// --shard-index N, --shard-count N, --threads N, --processes N, --timeout MS, --fail-limit N,
+	/// --repeat N, --until-fail, --retries N, --shuffle, --seed N, --stress NAME and the Options
+	/// selecting Tests
+	/// </summary>
+	/// <param name="argc">the Number of Arguments</param>
+	/// <param name="argv">the Arguments, the first is the Program Name</param>
+	/// <returns>false when an Argument is unknown or invalid</returns>
+	bool TestCollection::parseArguments(int argc, const char* const* argv) {
+		TestCollection& instance = Instance();
+		size_t shardIndex = 0, shardCount = 1;
+
+		for (int i = 1; i < argc; i++) {
+			//accepts both "--option value" and "--option=value"
+			std::string option = argv[i];
+			if (option == "--list") {
+				instance.mListing = true;
+				continue;
+			} else if (option == "--until-fail") {
+				instance.mUntilFail = true;
+				continue;
+			} else if (option == "--shuffle") {
+				instance.mShuffle = true;
+				continue;
+			}
+
+			std::string value;
+			size_t equals = option.find('=');
+			if (equals != std::string::npos) {
+				value = option.substr(equals + 1);
+				option.erase(equals);
+			} else if (i + 1 < argc) {
+				value = argv[++i];
+			}
+
+			if (option == "--filter") {
+				instance.mFilter.include(value);
+				continue;
+			} else if (option == "--exclude") {
+				instance.mFilter.exclude(value);
+				continue;
+			} else if (option == "--tag") {
+				instance.mFilter.includeTag(value);
+				continue;
+			} else if (option == "--exclude-tag") {
+				instance.mFilter.excludeTag(value);
+				continue;
+			} else if (option == "--filter-regex") {
+				if (instance.mFilter.includeRegex(value)) continue;
+				std::cerr << "invalid regular expression for " << option << ": '" << value << "'\n";
+				return false;
+			} else if (option == "--rerun-failed") {
+				if (instance.mFilter.loadFailed(value)) continue;
+				std::cerr << "cannot read the results of the previous run: '" << value << "'\n";
+				return false;
+			} else if (option == "--changed") {
+				if (instance.mFilter.loadChanged(value)) continue;
+				std::cerr << "cannot read the list of changed files: '" << value << "'\n";
+				return false;
+			} else if (option == "--stress") {
+				if (setStress(value)) continue;
+				std::cerr << "no TEST_CASE to stress named '" << value << "'\n";
+				return false;
+			}
+
+			char* end = nullptr;
+			unsigned long long number = std::strtoull(value.c_str(), &end, 10);
+			if (value.empty() || *end != '\0' || value[0] == '-') {
+				std::cerr << "invalid value for " << option << ": '" << value << "'\n";
+				return false;
+			}
+
+			if (option == "--shard-index") shardIndex = static_cast<size_t>(number);
+			else if (option == "--shard-count") shardCount = static_cast<size_t>(number);
+			else if (option == "--threads") instance.mThreadCount = static_cast<size_t>(number);
+			else if (option == "--processes") instance.mProcessCount = static_cast<size_t>(number);
+			else if (option == "--timeout") instance.mTimeout = static_cast<double>(number);
+			else if (option == "--fail-limit") instance.mFailLimit = static_cast<uint64_t>(number);
+			else if (option == "--repeat") instance.mRepeat = static_cast<uint64_t>(number);
+			else if (option == "--retries") instance.mRetries = static_cast<uint32_t>(number);
+			else if (option == "--seed") {
+				//a seed only makes sense to replay a shuffled order
+				instance.mShuffle = true;
+				instance.mSeed = static_cast<uint64_t>(number);
+			}
+			else {
+				std::cerr << "unknown option: " << option << '\n';
+				return false;
+			}
+		}
+
+		if (shardCount == 0 || shardIndex >= shardCount) {
+			std::cerr << "shard index " << shardIndex << " is out of range for " << shardCount << " shards\n";
+			return false;
+		}
+		setShard(shardIndex, shardCount);
+		return true;
+	}
+
+	/// <summary>
+	/// returns weather --list asked to list the Tests instead of running them
+	/// </summary>
+	/// <returns>true when listTests should be called instead of runTests</returns>
+	bool TestCollection::isListing() {
+		return Instance().mListing;
+	}
+
+	/// <summary>
+	/// Writes the Names of the selected Tests, one per Line, instead of running them
 	/// </summary>
 	/// <param name="stream">the stream to write to</param>
-	void TestCollection::report(std::ostream& stream, bool color) {
+	void TestCollection::listTests(std::ostream& stream) {
+		selectTests();
+		selectShard();
+
+		for (auto test : Instance().mRun.mTests)
+			stream << test->getName() << '\n';
+		for (auto testCase : Instance().mRun.mCases)
+			stream << testCase->getName() << '\t' << testCase->getLocation().mFile << ':' << testCase->getLocation().mLine << '\n';
+	}
+
+	/// <summary>
+	/// Returns the Filter selecting the Tests of the Run
+	/// </summary>
+	/// <returns>the Filter, applied when runTests starts</returns>
+	TestFilter& TestCollection::getFilter() {
+		return Instance().mFilter;
+	}
+
+	/// <summary>
+	/// Loads the Durations of earlier Runs used to balance the Shards
+	/// and to start the longest Tests first
+	/// </summary>
+	/// <param name="path">the File written by saveHistory</param>
+	/// <returns>false when the File could not be read</returns>
+	bool TestCollection::loadHistory(const std::string& path) {
+		return Instance().mHistory.load(path);
+	}
+
+	/// <summary>
+	/// Adds the Durations of this Run to the loaded History and writes it to a File
+	/// </summary>
+	/// <param name="path">the File to write</param>
+	/// <returns>false when the File could not be written</returns>
+	bool TestCollection::saveHistory(const std::string& path) {
+		TimingDatabase& history = Instance().mHistory;
+
+		for (auto test : ranTests()) {
+			if (test->isAbandoned() || !test->mFinished) continue;
+
+			//moving average over about the last 8 runs, so one slow run doesn't reshuffle the shards
+			double time = test->getTime().count();
+			Timing timing;
+			if (const Timing* previous = history.find(std::string(test->getName()))) {
+				timing.mSamples = previous->mSamples + 1;
+				timing.mMean = previous->mMean + (time - previous->mMean) / static_cast<double>(std::min<uint64_t>(timing.mSamples, 8));
+			} else {
+				timing.mMean = time;
+				timing.mSamples = 1;
+			}
+			history.set(std::string(test->getName()), timing);
+		}
+		return history.save(path);
+	}
 
-		auto repeat = [](char c, uint32_t times) -> utString {
-			std::string result = "";
-			for (; times--;)
-				result += c;
-			return result;
-		};
-
-		constexpr uint32_t seperator_width = 90;
-		constexpr uint32_t indent = 14;
-
-		std::map<const char*, const char*> colorMap;
-		colorMap["reset"] = "";
-		colorMap["green"] = "";
-		colorMap["red"] = "";
-		colorMap["yellow"] = "";
-		colorMap["orange"] = "";
-
-		if (color) {
-			colorMap["reset"]	= "\x1b[0m";
-			colorMap["green"]	= "\x1b[38;5;40m";
-			colorMap["red"]		= "\x1b[38;5;160m";
-			colorMap["yellow"]	= "\x1b[38;5;226m";
-			colorMap["orange"]	= "\x1b[38;5;208m";
-		}
-
-		//change Unit Test Headline Color based on tests passed or failed.
-		//green: all tests passed
-		//red: all tests failed
-		//yellow: both failed and passed tests
-		//orange: no tests being run
-		switch ((Instance().mFailCount > 0 ? 1 : 0) + (Instance().mPassCount > 0 ? 2 : 0)) {
-		case 1:
-			stream << colorMap["red"];
-			break;
-		case 2:
-			stream << colorMap["green"];
-			break;
-		case 3:
-			stream << colorMap["yellow"];
-			break;
-		default:
-			stream << colorMap["orange"];
-			break;
-		}
-
-		stream << "Unit Test Report:" << colorMap["reset"] << '\n';
-
-		for (auto& testable : Instance().mTests) {
-
-			stream << std::setw(seperator_width) << std::left << std::setfill('=');
-			stream << repeat('=', seperator_width / 2 - testable->getName().size() / 2 -2) + '[' + testable->getName() + ']' << '\n';
-
-			stream << std::setfill(' ')
-			<< std::setw(indent) << std::left << "Duration: " << testable->getTime().count() << "ms\n"
-			<< std::setw(indent) << std::left << "Status: ";
-			if (testable->hasFailed()) {
-				stream << colorMap["red"] << "failed" << colorMap["reset"] << "\nReport:\n";
-				testable->mResult.reportFails(stream, indent);
-				testable->mResult.reportError(stream, indent);
-			} else stream << colorMap["green"] << "passed" << colorMap["reset"] << '\n';
-		}
-		stream << std::setw(seperator_width) << std::setfill('=') << '=' << '\n';
-		stream << std::setfill(' ')
-			<< "Conclusion: \n"
-			<< std::setw(indent) << "Failed Tests: " << Instance().mFailCount << '\n'
-			<< std::setw(indent) << "Passed Tests: " << Instance().mPassCount << '\n'
-			<< std::setw(indent) << "Duration: " << Instance().mDuration.count() << "ms\n";
+	/// <summary>
+	/// Loads the Timings of an earlier Run to compare this Run against
+	/// </summary>
+	/// <param name="path">the File written by saveTimings</param>
+	/// <returns>false when the File could not be read</returns>
+	bool TestCollection::loadBaseline(const std::string& path) {
+		return Instance().mBaseline.load(path);
+	}
 
+	/// <summary>
+	/// Writes the Timings of all finished Tests to a File
+	/// </summary>
+	/// <param name="path">the File to write</param>
+	/// <returns>false when the File could not be written</returns>
+	bool TestCollection::saveTimings(const std::string& path) {
+		TimingDatabase timings;
+		for (auto test : ranTests())
+			if (!test->isAbandoned() && test->mFinished) timings.set(std::string(test->getName()), test->getTiming());
+
+		return timings.save(path);
+	}
+
+	/// <summary>
+	/// Writes the Performance Counters of all finished Tests to a tab separated File
+	/// </summary>
+	/// <param name="path">the File to write</param>
+	/// <returns>false when the File could not be written</returns>
+	bool TestCollection::saveCounters(const std::string& path) {
+		std::ofstream stream(path);
+		if (!stream) return false;
+
+		stream << "# name";
+		for (int i = 0; i < PerfCounters::CounterCount; i++)
+			stream << '\t' << PerfCounters::name(static_cast<PerfCounters::Counter>(i));
+		stream << '\n';
+
+		for (auto test : ranTests()) {
+			if (test->isAbandoned() || !test->mFinished) continue;
+
+			//unavailable counters are written as '-'
+			stream << test->getName();
+			for (int i = 0; i < PerfCounters::CounterCount; i++) {
+				stream << '\t';
+				if (test->mCounters.mValid[i]) stream << test->mCounters.mValues[i];
+				else stream << '-';
+			}
+			stream << '\n';
+		}
+		return static_cast<bool>(stream);
+	}
+
+	/// <summary>
+	/// Writes the Statistics of every Test over the Iterations of the last Run to a tab separated File
+	/// </summary>
+	/// <param name="path">the File to write</param>
+	/// <returns>false when the File could not be written</returns>
+	bool TestCollection::saveStatistics(const std::string& path) {
+		std::ofstream stream(path);
+		if (!stream) return false;
+
+		stream << "# name\truns\tfailures\tflaky\tmean\tstddev\tmin\tmax\n";
+		for (const auto& entry : Instance().mRun.mStatistics) {
+			const TestStatistics& statistics = entry.second;
+			stream << entry.first << '\t' << statistics.getRuns() << '\t' << statistics.getFailures()
+				<< '\t' << (statistics.isFlaky() ? "yes" : "no")
+				<< '\t' << statistics.getMean() << '\t' << statistics.getStdDev()
+				<< '\t' << statistics.getMin() << '\t' << statistics.getMax() << '\n';
+		}
+		return static_cast<bool>(stream);
+	}
+
+	/// <summary>
+	/// Returns the Statistics of every Test over the Iterations of the last Run
+	/// </summary>
+	/// <returns>the Statistics by Name of the Test</returns>
+	const std::map<std::string, TestStatistics>& TestCollection::getStatistics() {
+		return Instance().mRun.mStatistics;
+	}
+
+	/// <summary>
+	/// Enables recording Hardware Performance Counters per Test
+	/// </summary>
+	/// <param name="enable">true to record the Counters</param>
+	void TestCollection::setPerfCounters(bool enable) {
+		Instance().mPerfCounters = enable;
+	}
+
+	/// <summary>
+	/// Enables reporting the Heap Allocations of every Test.
+	/// </summary>
+	/// <param name="enable">true to report the Allocations</param>
+	void TestCollection::setAllocationTracking(bool enable) {
+		Instance().mReportAllocations = enable;
+	}
+
+	/// <summary>
+	/// Sets how much slower than the Baseline a Test may get
+	/// before it is reported as perf-regressed
+	/// </summary>
+	/// <param name="tolerance">the allowed relative Slowdown, 0.1 is 10%</param>
+	/// <param name="minimum">the smallest Slowdown in Milliseconds counted for plain Tests</param>
+	void TestCollection::setRegressionTolerance(double tolerance, double minimum) {
+		Instance().mTolerance = tolerance;
+		Instance().mMinimumRegression = minimum;
+	}
+
+	/// <summary>
+	/// Adds a Reporter that gets the Events of the Run while it happens
+	/// </summary>
+	/// <param name="reporter">the Reporter, it has to outlive the Run</param>
+	void TestCollection::addReporter(Reporter* reporter) {
+		ReportQueue::addReporter(reporter);
+	}
+
+	/// <summary>
+	/// returns weather the Heap Allocations of every Test are reported
+	/// </summary>
+	/// <returns>true when enabled with setAllocationTracking</returns>
+	bool TestCollection::isAllocationTracking() {
+		return Instance().mReportAllocations;
+	}
+
+	/// <summary>
+	/// writes a Report to the given ostream
+	/// </summary>
+	/// <param name="stream">the stream to write to</param>
+	void TestCollection::report(std::ostream& stream, bool color) {
+		//the same events a streaming reporter got, in the order the tests were added
+		std::vector<Testable*> tests = ranTests();
+		TextReporter reporter(stream, color);
+		reporter.suiteStart(tests.size());
+		for (auto test : tests)
+			reporter.testEnd(*test);
+		reporter.suiteEnd(Instance().mRun.mSummary);
 	}
 
 }
\ No newline at end of file
@@ -2,30 +2,74 @@
 #ifndef UT_TEST_COLLECTION_H
 #define UT_TEST_COLLECTION_H
 
+#include <atomic>
 #include <list>
+#include <map>
 #include <ostream>
+#include <string>
+#include <vector>
 #include "Testable.h"
+#include "Reporter.h"
+#include "TestFilter.h"
+#include "TestCase.h"
+#include "RunContext.h"
 
 namespace Test {
 	
+	class ProcessRunner;
+	class Watchdog;
+
 	/// <summary>
 	/// TestCollection Singleton
 	/// </summary>
 	class TestCollection {
+		friend ProcessRunner;
+
 	private:	// internal Defines
 		typedef std::list<Testable*> testable_collection;
 		typedef std::chrono::high_resolution_clock clock;
 		typedef std::chrono::time_point<clock> timepoint;
 		typedef std::chrono::duration<double, std::milli> duration;
 
+		/// <summary>
+		/// A Test or the Descriptor of a TEST_CASE, the other one is null
+		/// </summary>
+		struct Dispatch {
+			Testable* mTest;
+			TestCase* mCase;
+		};
+
 	private:	//private Members
-		static TestCollection* mInstance;
 		testable_collection mTests;
+		RunContext mRun;
 
-		uint64_t mFailCount = 0;
-		uint64_t mPassCount = 0;
+		size_t mThreadCount = 0;
+		size_t mProcessCount = 0;
+
+		double mTimeout = 0;
+		std::atomic<Watchdog*> mWatchdog{ nullptr };
+		uint64_t mFailLimit = 0;
+		uint64_t mRepeat = 0;
+		bool mUntilFail = false;
+		uint32_t mRetries = 0;
+		bool mShuffle = false;
+		uint64_t mSeed = 0;
+		std::string mStress;
+
+		TimingDatabase mBaseline;
+		TimingDatabase mHistory;
+		size_t mShardIndex = 0;
+		size_t mShardCount = 1;
+		TestFilter mFilter;
+		bool mListing = false;
+		double mTolerance = 0.1;
+		double mMinimumRegression = 1.0;
+
+		bool mPerfCounters = false;
+		bool mReportAllocations = false;
+
+		bool mCaptureFileOutput = false;
 
-		duration mDuration;
 
 	public:		//Constructors and Destructors
 		TestCollection() = default;
@@ -40,6 +84,144 @@ namespace Test {
 		/// <param name="message">the error message to display</param>
 		void error(const utString& message);
 
+		/// <summary>
+		/// Runs a single Test and records its Outcome. A failed Test is
+		/// run again, up to the Number of Retries.
+		/// </summary>
+		/// <param name="test">the Test to run</param>
+		static void runTest(Testable* test);
+
+		/// <summary>
+		/// Runs a single Attempt of a Test, with its Watchdog and Counters
+		/// </summary>
+		/// <param name="test">the Test to run</param>
+		static void runAttempt(Testable* test);
+
+		/// <summary>
+		/// Tells the Fixtures of a Test that it finished
+		/// </summary>
+		/// <param name="test">the finished Test</param>
+		static void releaseFixtures(Testable* test);
+
+		/// <summary>
+		/// Counts a finished Test as passed or failed
+		/// </summary>
+		/// <param name="test">the finished Test</param>
+		static void record(Testable* test);
+
+		/// <summary>
+		/// Runs a Test on a Worker Thread unless the global Timeout gave up on it before
+		/// </summary>
+		/// <param name="test">the Test to run</param>
+		static void runClaimed(Testable* test);
+
+		/// <summary>
+		/// Constructs the Test of a TEST_CASE and applies the Settings of the Run
+		/// </summary>
+		/// <param name="testCase">the Descriptor of the Test</param>
+		/// <returns>the Test</returns>
+		static Testable* materialize(TestCase* testCase);
+
+		/// <summary>
+		/// Constructs and runs the Test of a TEST_CASE on a Worker Thread,
+		/// unless the global Timeout gave up on it before
+		/// </summary>
+		/// <param name="testCase">the Descriptor of the Test</param>
+		static void runCase(TestCase* testCase);
+
+		/// <summary>
+		/// Runs Tests on a Pool of Worker Threads until they are done or the Deadline passed
+		/// </summary>
+		/// <param name="entries">the Tests and TEST_CASEs to run, in the Order they are started in</param>
+		/// <param name="threads">the Number of Threads, 0 uses one per hardware Thread</param>
+		/// <param name="deadline">the global Deadline</param>
+		/// <param name="workers">receives the Number of Threads used</param>
+		/// <returns>false when the Deadline passed and the Pool was abandoned</returns>
+		static bool runOnPool(const std::vector<Dispatch>& entries, size_t threads, std::chrono::steady_clock::time_point deadline, size_t& workers);
+
+		/// <summary>
+		/// Fails all Tests that did not finish before the global Timeout.
+		/// Tests that did not start are reported as not run, running Tests
+		/// are asked to stop and abandoned.
+		/// </summary>
+		/// <param name="tests">the Tests to check</param>
+		/// <param name="cases">the TEST_CASEs to check</param>
+		static void giveUp(const std::vector<Testable*>& tests, const std::vector<TestCase*>& cases);
+
+		/// <summary>
+		/// Drops all Tests the Filter doesn't select
+		/// </summary>
+		static void selectTests();
+
+		/// <summary>
+		/// Drops all Tests that belong to other Shards
+		/// </summary>
+		static void selectShard();
+
+		/// <summary>
+		/// Selects one Copy of the stressed TEST_CASE per Worker Thread instead of the Tests
+		/// </summary>
+		static void selectStress();
+
+		/// <summary>
+		/// returns weather the Tests run in forked Worker Processes
+		/// </summary>
+		/// <returns>true when a Process Count is set and Processes are supported</returns>
+		static bool isIsolated();
+
+		/// <summary>
+		/// Counts the Tests of this Run using each Fixture,
+		/// so the last of them can tear it down
+		/// </summary>
+		static void prepareFixtures();
+
+		/// <summary>
+		/// returns the Order Tests are dispatched in: longest first by
+		/// the loaded History, in Order of Registration when there is none
+		/// </summary>
+		/// <param name="names">the Names of the Tests</param>
+		/// <returns>the Indices of the Tests in Dispatch Order</returns>
+		static std::vector<size_t> longestFirst(const std::vector<std::string>& names);
+
+		/// <summary>
+		/// returns the Order Tests are dispatched in: shuffled by the Seed of the
+		/// Run and the Iteration when shuffling, otherwise longest first
+		/// </summary>
+		/// <param name="names">the Names of the Tests</param>
+		/// <returns>the Indices of the Tests in Dispatch Order</returns>
+		static std::vector<size_t> arrange(const std::vector<std::string>& names);
+
+		/// <summary>
+		/// returns the Tests and TEST_CASEs in the Order they are dispatched,
+		/// both arranged together so neither always starts last
+		/// </summary>
+		/// <returns>the Tests and Descriptors to run</returns>
+		static std::vector<Dispatch> dispatchOrder();
+
+		/// <summary>
+		/// Compares the Timing of a finished Test against the Baseline
+		/// </summary>
+		/// <param name="test">the finished Test</param>
+		static void checkRegression(Testable* test);
+
+		/// <summary>
+		/// Records the Outcome of a finished Test and hands it to the Reporters
+		/// </summary>
+		/// <param name="test">the finished Test</param>
+		static void complete(Testable* test);
+
+		/// <summary>
+		/// Runs the selected Tests once and hands the Outcome to the Reporters
+		/// </summary>
+		/// <param name="iteration">the Number of the Iteration, starting at 1</param>
+		static void runIteration(uint64_t iteration);
+
+		/// <summary>
+		/// returns the Tests of the last Run, including the constructed TEST_CASEs
+		/// </summary>
+		/// <returns>the Tests</returns>
+		static std::vector<Testable*> ranTests();
+
 	public:		//exposed Functionality
 		/// <summary>
 		/// Get the Instance of the TestCollection
@@ -54,10 +236,224 @@ namespace Test {
 		static void addTest(Testable* test);
 
 		/// <summary>
-		/// Runs all the Tests
+		/// Sets the Number of Worker Threads used to run the Tests
+		/// </summary>
+		/// <param name="threads">the Number of Threads, 0 uses one per hardware Thread</param>
+		static void setThreadCount(size_t threads);
+
+		/// <summary>
+		/// Runs the Tests in forked Worker Processes instead of Threads, so a
+		/// crashing Test is reported as failed instead of ending the Run.
+		/// Only on POSIX Systems, elsewhere the Tests keep running in Threads.
+		/// </summary>
+		/// <param name="processes">the Number of Worker Processes, 0 runs the Tests in Threads</param>
+		static void setProcessCount(size_t processes);
+
+		/// <summary>
+		/// Sets the Time the whole Run may take. Once it passed, Tests that did not
+		/// start yet are failed as not run. Running Tests are asked to stop through
+		/// Testable::shouldStop and abandoned on their Threads, or killed when they
+		/// run in Worker Processes. The Process should exit soon after an abandoned Run.
+		/// </summary>
+		/// <param name="milliseconds">the Time in Milliseconds, 0 for no Limit</param>
+		static void setTimeout(double milliseconds);
+
+		/// <summary>
+		/// Sets the Number of Fails stored per Test, for Tests that didn't set
+		/// their own with Testable::setFailLimit. Later Fails are only counted.
+		/// </summary>
+		/// <param name="limit">the Number of Fails, 0 for no Limit</param>
+		static void setFailLimit(uint64_t limit);
+
+		/// <summary>
+		/// Runs the Tests several Times in one Call of runTests, to find flaky Tests
+		/// or soak the Code under Test. Every Iteration is reported as a Run of its
+		/// own, the Statistics over all Iterations are kept by getStatistics.
+		/// </summary>
+		/// <param name="count">the Number of Iterations, 0 for no Limit with untilFail</param>
+		/// <param name="untilFail">true to stop after the first Iteration in which a Test failed</param>
+		static void setRepeat(uint64_t count, bool untilFail = false);
+
+		/// <summary>
+		/// Runs a failed Test again, up to a Number of Times. A Test that passes
+		/// on a Retry counts as passed, but is reported as flaky. Timed out
+		/// Tests are not retried.
+		/// </summary>
+		/// <param name="retries">the Number of Retries, 0 to report the first Failure</param>
+		static void setRetries(uint32_t retries);
+
+		/// <summary>
+		/// Dispatches the Tests in a random Order instead of longest first, to find
+		/// Tests that depend on each other. The Seed is reported with the Summary,
+		/// running again with it replays the same Order.
+		/// </summary>
+		/// <param name="shuffle">true to shuffle the Tests</param>
+		/// <param name="seed">the Seed, 0 for a new random Seed every Run</param>
+		static void setShuffle(bool shuffle, uint64_t seed = 0);
+
+		/// <summary>
+		/// Runs only a single TEST_CASE, as one Copy per Worker Thread at the same
+		/// Time, to find Races in the Test and the Code under Test. Every Copy is
+		/// reported on its own as "name#N".
+		/// </summary>
+		/// <param name="name">the Name of the TEST_CASE, empty to run the Tests normally</param>
+		/// <returns>false when there is no TEST_CASE with that Name</returns>
+		static bool setStress(const std::string& name);
+
+		/// <summary>
+		/// Returns the Seed the Tests of the last Run were shuffled with
+		/// </summary>
+		/// <returns>the Seed, 0 when they weren't shuffled</returns>
+		static uint64_t getSeed();
+
+		/// <summary>
+		/// Runs only one Shard of the Tests, so the Suite can be split across Machines.
+		/// Tests are balanced by the Durations loaded with loadHistory; all Machines
+		/// need the same History to agree on the Split.
+		/// </summary>
+		/// <param name="index">the Shard to run, starting at 0</param>
+		/// <param name="count">the Number of Shards</param>
+		static void setShard(size_t index, size_t count);
+
+		/// <summary>
+		/// Applies the Command Line Options of the Runner:
+		/// --shard-index N, --shard-count N, --threads N, --processes N, --timeout MS, --fail-limit N,
+		/// --repeat N, --until-fail, --retries N, --shuffle, --seed N, --stress NAME,
+		/// and to select Tests: --filter GLOB, --exclude GLOB, --filter-regex EXPR, --tag NAME,
+		/// --exclude-tag NAME, --rerun-failed REPORT.jsonl and --changed FILELIST.
+		/// Every selecting Option may be given several Times. --list only lists the
+		/// selected Tests, see isListing.
+		/// </summary>
+		/// <param name="argc">the Number of Arguments</param>
+		/// <param name="argv">the Arguments, the first is the Program Name</param>
+		/// <returns>false when an Argument is unknown or invalid</returns>
+		static bool parseArguments(int argc, const char* const* argv);
+
+		/// <summary>
+		/// returns weather --list asked to list the Tests instead of running them
+		/// </summary>
+		/// <returns>true when listTests should be called instead of runTests</returns>
+		static bool isListing();
+
+		/// <summary>
+		/// Writes the Names of the selected Tests, one per Line, instead of running them.
+		/// TEST_CASEs are listed with their Location and without being constructed.
+		/// Shards are split by the loaded History, so load it before listing a Shard.
+		/// </summary>
+		/// <param name="stream">the stream to write to</param>
+		static void listTests(std::ostream& stream);
+
+		/// <summary>
+		/// Returns the Filter selecting the Tests of the Run, to select Tests
+		/// from Code instead of the Command Line
+		/// </summary>
+		/// <returns>the Filter, applied when runTests starts</returns>
+		static TestFilter& getFilter();
+
+		/// <summary>
+		/// Loads the Durations of earlier Runs used to balance the Shards
+		/// and to start the longest Tests first
+		/// </summary>
+		/// <param name="path">the File written by saveHistory</param>
+		/// <returns>false when the File could not be read</returns>
+		static bool loadHistory(const std::string& path);
+
+		/// <summary>
+		/// Adds the Durations of this Run to the loaded History and writes it to a File.
+		/// Tests that did not run, like those of other Shards, keep their old Durations.
+		/// </summary>
+		/// <param name="path">the File to write</param>
+		/// <returns>false when the File could not be written</returns>
+		static bool saveHistory(const std::string& path);
+
+		/// <summary>
+		/// Enables capturing Output written directly to the stdout File Descriptor
+		/// (printf, write) while the Tests run. This Output is shared by all Tests
+		/// and reported once in the Conclusion.
+		/// </summary>
+		/// <param name="capture">true to enable the Capture</param>
+		static void setCaptureFileOutput(bool capture);
+
+		/// <summary>
+		/// Loads the Timings of an earlier Run to compare this Run against
+		/// </summary>
+		/// <param name="path">the File written by saveTimings</param>
+		/// <returns>false when the File could not be read</returns>
+		static bool loadBaseline(const std::string& path);
+
+		/// <summary>
+		/// Writes the Timings of all finished Tests to a File
+		/// </summary>
+		/// <param name="path">the File to write</param>
+		/// <returns>false when the File could not be written</returns>
+		static bool saveTimings(const std::string& path);
+
+		/// <summary>
+		/// Writes the Performance Counters of all finished Tests to a tab separated File
+		/// </summary>
+		/// <param name="path">the File to write</param>
+		/// <returns>false when the File could not be written</returns>
+		static bool saveCounters(const std::string& path);
+
+		/// <summary>
+		/// Writes the Statistics of every Test over the Iterations of the
+		/// last Run to a tab separated File
+		/// </summary>
+		/// <param name="path">the File to write</param>
+		/// <returns>false when the File could not be written</returns>
+		static bool saveStatistics(const std::string& path);
+
+		/// <summary>
+		/// Returns the Statistics of every Test over the Iterations of the last Run:
+		/// how often it ran and failed, and the Distribution of its Durations
+		/// </summary>
+		/// <returns>the Statistics by Name of the Test</returns>
+		static const std::map<std::string, TestStatistics>& getStatistics();
+
+		/// <summary>
+		/// Enables recording Hardware Performance Counters (cycles, instructions,
+		/// cache and branch misses, context switches) per Test. Only available
+		/// on Linux, Counters the Kernel refuses to open are left out.
+		/// </summary>
+		/// <param name="enable">true to record the Counters</param>
+		static void setPerfCounters(bool enable);
+
+		/// <summary>
+		/// Enables reporting the Heap Allocations of every Test.
+		/// Allocations are only counted when compiled with UT_TRACK_ALLOCATIONS.
+		/// </summary>
+		/// <param name="enable">true to report the Allocations</param>
+		static void setAllocationTracking(bool enable);
+
+		/// <summary>
+		/// Sets how much slower than the Baseline a Test may get
+		/// before it is reported as perf-regressed
+		/// </summary>
+		/// <param name="tolerance">the allowed relative Slowdown, 0.1 is 10%</param>
+		/// <param name="minimum">the smallest Slowdown in Milliseconds counted for plain Tests</param>
+		static void setRegressionTolerance(double tolerance, double minimum = 1.0);
+
+		/// <summary>
+		/// Runs all the Tests on a Pool of Worker Threads or Processes. May be called
+		/// again, every Call selects the Tests anew and resets them before they run.
 		/// </summary>
 		static void runTests();
 
+		/// <summary>
+		/// Adds a Reporter that gets the Events of the Run while it happens.
+		/// Events are formatted on a separate Writer Thread, so Reporters never
+		/// slow down the Tests. Reporters writing to std::cout reach the Console
+		/// even with setCaptureFileOutput, the Writer bypasses the Capture.
+		/// </summary>
+		/// <param name="reporter">the Reporter, it has to outlive the Run</param>
+		static void addReporter(Reporter* reporter);
+
+		/// <summary>
+		/// returns weather the Heap Allocations of every Test are reported
+		/// </summary>
+		/// <returns>true when enabled with setAllocationTracking</returns>
+		static bool isAllocationTracking();
+
 		/// <summary>
 		/// writes a Report to the given ostream
 		/// </summary>
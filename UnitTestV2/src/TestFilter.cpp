@@ -0,0 +1,241 @@
+#include "TestFilter.h"
+#include "Testable.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+
+namespace Test {
+
+	namespace {
+		/// <summary>
+		/// Reads a String Value of a JSON Object written on one Line
+		/// </summary>
+		/// <param name="line">the Line</param>
+		/// <param name="key">the Key of the Value</param>
+		/// <param name="value">receives the unescaped Value</param>
+		/// <returns>false when the Line has no such String</returns>
+		bool readString(const std::string& line, const std::string& key, std::string& value) {
+			size_t position = line.find("\"" + key + "\":\"");
+			if (position == std::string::npos) return false;
+
+			value.clear();
+			for (size_t i = position + key.size() + 4; i < line.size(); i++) {
+				char c = line[i];
+				if (c == '"') return true;
+				if (c != '\\' || ++i == line.size()) {
+					value += c;
+					continue;
+				}
+
+				switch (line[i]) {
+				case 'n': value += '\n'; break;
+				case 'r': value += '\r'; break;
+				case 't': value += '\t'; break;
+				case 'u':
+					//the JsonReporter only escapes control characters this way
+					if (i + 4 >= line.size()) return false;
+					value += static_cast<char>(std::strtoul(line.substr(i + 1, 4).c_str(), nullptr, 16));
+					i += 4;
+					break;
+				default: value += line[i];
+				}
+			}
+			return false;
+		}
+
+		/// <summary>
+		/// returns weather a Tag is in a List of Tags
+		/// </summary>
+		bool contains(const std::vector<std::string>& tags, const std::string& tag) {
+			return std::find(tags.begin(), tags.end(), tag) != tags.end();
+		}
+	}
+
+
+	/// <summary>
+	/// returns weather one of the Files covered by a Test changed
+	/// </summary>
+	/// <param name="sources">the Source Files the Test exercises</param>
+	/// <returns>true when the Test is affected or covers no Files</returns>
+	bool TestFilter::isAffected(const std::vector<std::string>& sources) const {
+		//without its files the test can't be ruled out
+		if (sources.empty()) return true;
+
+		for (const auto& source : sources)
+			for (const auto& changed : mChanged)
+				if (samePath(source, changed)) return true;
+		return false;
+	}
+
+	/// <summary>
+	/// Runs the Tests whose Name matches a Glob Pattern
+	/// </summary>
+	/// <param name="pattern">the Pattern</param>
+	void TestFilter::include(const std::string& pattern) {
+		mIncluded.push_back(pattern);
+	}
+
+	/// <summary>
+	/// Skips the Tests whose Name matches a Glob Pattern
+	/// </summary>
+	/// <param name="pattern">the Pattern</param>
+	void TestFilter::exclude(const std::string& pattern) {
+		mExcluded.push_back(pattern);
+	}
+
+	/// <summary>
+	/// Runs the Tests whose Name contains a Match of a regular Expression
+	/// </summary>
+	/// <param name="expression">the ECMAScript Expression</param>
+	/// <returns>false when the Expression is invalid</returns>
+	bool TestFilter::includeRegex(const std::string& expression) {
+		try {
+			mExpressions.emplace_back(expression, std::regex::ECMAScript | std::regex::optimize);
+		} catch (std::regex_error&) {
+			return false;
+		}
+		return true;
+	}
+
+	/// <summary>
+	/// Runs the Tests with a Tag
+	/// </summary>
+	/// <param name="name">the Name of the Tag</param>
+	void TestFilter::includeTag(const std::string& name) {
+		mTags.push_back(name);
+	}
+
+	/// <summary>
+	/// Skips the Tests with a Tag
+	/// </summary>
+	/// <param name="name">the Name of the Tag</param>
+	void TestFilter::excludeTag(const std::string& name) {
+		mExcludedTags.push_back(name);
+	}
+
+	/// <summary>
+	/// Runs only the Tests that did not pass in a previous Run
+	/// </summary>
+	/// <param name="path">the File written by the JsonReporter of that Run</param>
+	/// <returns>false when the File could not be read</returns>
+	bool TestFilter::loadFailed(const std::string& path) {
+		std::ifstream stream(path);
+		if (!stream) return false;
+
+		mFailedOnly = true;
+		std::string line, type, name, status;
+		while (std::getline(stream, line)) {
+			if (!readString(line, "type", type) || type != "test") continue;
+			if (!readString(line, "name", name) || !readString(line, "status", status)) continue;
+
+			//a perf regression isn't fixed by running the test again
+			if (status != "passed" && status != "perf-regressed") mFailed.insert(name);
+		}
+		return true;
+	}
+
+	/// <summary>
+	/// Runs only the Tests covering one of the changed Files
+	/// </summary>
+	/// <param name="path">a File listing the changed Files one per Line</param>
+	/// <returns>false when the File could not be read</returns>
+	bool TestFilter::loadChanged(const std::string& path) {
+		std::ifstream stream(path);
+		if (!stream) return false;
+
+		mChangedOnly = true;
+		std::string line;
+		while (std::getline(stream, line)) {
+			while (!line.empty() && (line.back() == '\r' || line.back() == ' ')) line.pop_back();
+			if (!line.empty()) mChanged.push_back(line);
+		}
+		return true;
+	}
+
+	/// <summary>
+	/// returns weather a Test is selected
+	/// </summary>
+	/// <param name="test">the Test</param>
+	/// <returns>true when the Test runs</returns>
+	bool TestFilter::matches(const Testable& test) const {
+		return matches(std::string(test.getName()), test.getTags(), test.getSources());
+	}
+
+	/// <summary>
+	/// returns weather a Test is selected, for Tests that are not constructed yet
+	/// </summary>
+	/// <param name="name">the Name of the Test</param>
+	/// <param name="tags">the Tags of the Test</param>
+	/// <param name="sources">the Source Files the Test exercises</param>
+	/// <returns>true when the Test runs</returns>
+	bool TestFilter::matches(const std::string& name, const std::vector<std::string>& tags, const std::vector<std::string>& sources) const {
+		if (!mIncluded.empty() || !mExpressions.empty()) {
+			bool included = std::any_of(mIncluded.begin(), mIncluded.end(),
+				[&name](const std::string& pattern) { return glob(pattern, name); })
+				|| std::any_of(mExpressions.begin(), mExpressions.end(),
+				[&name](const std::regex& expression) { return std::regex_search(name, expression); });
+			if (!included) return false;
+		}
+		for (const auto& pattern : mExcluded)
+			if (glob(pattern, name)) return false;
+
+		if (!mTags.empty() && std::none_of(mTags.begin(), mTags.end(),
+			[&tags](const std::string& tag) { return contains(tags, tag); })) return false;
+		for (const auto& tag : mExcludedTags)
+			if (contains(tags, tag)) return false;
+
+		if (mFailedOnly && mFailed.count(name) == 0) return false;
+		if (mChangedOnly && !isAffected(sources)) return false;
+		return true;
+	}
+
+	/// <summary>
+	/// returns weather a Name matches a Glob Pattern
+	/// </summary>
+	/// <param name="pattern">the Pattern, '*' matches any Text and '?' a single Character</param>
+	/// <param name="name">the Name</param>
+	/// <returns>true when the whole Name matches</returns>
+	bool TestFilter::glob(const std::string& pattern, const std::string& name) {
+		//on a mismatch only the last '*' has to take more characters, no recursion needed
+		size_t p = 0, n = 0;
+		size_t star = std::string::npos, resume = 0;
+		while (n < name.size()) {
+			if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n])) {
+				p++;
+				n++;
+			} else if (p < pattern.size() && pattern[p] == '*') {
+				star = p++;
+				resume = n;
+			} else if (star != std::string::npos) {
+				p = star + 1;
+				n = ++resume;
+			} else {
+				return false;
+			}
+		}
+		while (p < pattern.size() && pattern[p] == '*') p++;
+		return p == pattern.size();
+	}
+
+	/// <summary>
+	/// returns weather two Paths name the same File, when one is relative
+	/// to a Directory of the other
+	/// </summary>
+	/// <param name="a">the first Path</param>
+	/// <param name="b">the second Path</param>
+	/// <returns>true when the shorter Path is a trailing Part of the longer one</returns>
+	bool TestFilter::samePath(const std::string& a, const std::string& b) {
+		const std::string& shorter = a.size() < b.size() ? a : b;
+		const std::string& longer = a.size() < b.size() ? b : a;
+		if (shorter.empty()) return false;
+
+		auto separator = [](char c) { return c == '/' || c == '\\'; };
+		size_t offset = longer.size() - shorter.size();
+		for (size_t i = 0; i < shorter.size(); i++) {
+			char x = shorter[i], y = longer[offset + i];
+			if (x != y && !(separator(x) && separator(y))) return false;
+		}
+		//"src/a.cpp" is not "src/data.cpp"
+		return offset == 0 || separator(longer[offset - 1]) || separator(shorter[0]);
+	}
+}
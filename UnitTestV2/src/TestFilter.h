@@ -0,0 +1,134 @@
+#pragma once
+#ifndef UT_TEST_FILTER_H
+#define UT_TEST_FILTER_H
+
+#include <regex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace Test {
+
+	class Testable;
+
+	/// <summary>
+	/// Selects the Tests of a Run. A Test runs when its Name matches one of
+	/// the included Patterns (or there are none) and none of the excluded ones,
+	/// when it has one of the included Tags (or there are none) and none of the
+	/// excluded ones, when it failed in the previous Run if only those are
+	/// rerun, and when one of the Files it covers changed if only affected
+	/// Tests are run. All Conditions have to hold.
+	/// </summary>
+	class TestFilter {
+	private:	//private Members
+		std::vector<std::string> mIncluded;
+		std::vector<std::string> mExcluded;
+		std::vector<std::regex> mExpressions;
+		std::vector<std::string> mTags;
+		std::vector<std::string> mExcludedTags;
+
+		bool mFailedOnly = false;
+		std::set<std::string> mFailed;
+
+		bool mChangedOnly = false;
+		std::vector<std::string> mChanged;
+
+	public:		//Constructors and Destructors
+		/// <summary>
+		/// Creates a Filter that selects every Test
+		/// </summary>
+		TestFilter() = default;
+
+	private:	//internal functionality
+		/// <summary>
+		/// returns weather one of the Files covered by a Test changed
+		/// </summary>
+		/// <param name="sources">the Source Files the Test exercises</param>
+		/// <returns>true when the Test is affected or covers no Files</returns>
+		bool isAffected(const std::vector<std::string>& sources) const;
+
+	public:		//exposed Functionality
+		/// <summary>
+		/// Runs the Tests whose Name matches a Glob Pattern, '*' matches any
+		/// Text and '?' a single Character
+		/// </summary>
+		/// <param name="pattern">the Pattern</param>
+		void include(const std::string& pattern);
+
+		/// <summary>
+		/// Skips the Tests whose Name matches a Glob Pattern
+		/// </summary>
+		/// <param name="pattern">the Pattern</param>
+		void exclude(const std::string& pattern);
+
+		/// <summary>
+		/// Runs the Tests whose Name contains a Match of a regular Expression
+		/// </summary>
+		/// <param name="expression">the ECMAScript Expression</param>
+		/// <returns>false when the Expression is invalid</returns>
+		bool includeRegex(const std::string& expression);
+
+		/// <summary>
+		/// Runs the Tests with a Tag
+		/// </summary>
+		/// <param name="name">the Name of the Tag</param>
+		void includeTag(const std::string& name);
+
+		/// <summary>
+		/// Skips the Tests with a Tag
+		/// </summary>
+		/// <param name="name">the Name of the Tag</param>
+		void excludeTag(const std::string& name);
+
+		/// <summary>
+		/// Runs only the Tests that did not pass in a previous Run
+		/// </summary>
+		/// <param name="path">the File written by the JsonReporter of that Run</param>
+		/// <returns>false when the File could not be read</returns>
+		bool loadFailed(const std::string& path);
+
+		/// <summary>
+		/// Runs only the Tests covering one of the changed Files, and those
+		/// that don't declare their Files
+		/// </summary>
+		/// <param name="path">a File listing the changed Files one per Line, like the Output of git diff --name-only</param>
+		/// <returns>false when the File could not be read</returns>
+		bool loadChanged(const std::string& path);
+
+		/// <summary>
+		/// returns weather a Test is selected
+		/// </summary>
+		/// <param name="test">the Test</param>
+		/// <returns>true when the Test runs</returns>
+		bool matches(const Testable& test) const;
+
+		/// <summary>
+		/// returns weather a Test is selected, for Tests that are not constructed yet
+		/// </summary>
+		/// <param name="name">the Name of the Test</param>
+		/// <param name="tags">the Tags of the Test</param>
+		/// <param name="sources">the Source Files the Test exercises</param>
+		/// <returns>true when the Test runs</returns>
+		bool matches(const std::string& name, const std::vector<std::string>& tags, const std::vector<std::string>& sources) const;
+
+		/// <summary>
+		/// returns weather a Name matches a Glob Pattern
+		/// </summary>
+		/// <param name="pattern">the Pattern, '*' matches any Text and '?' a single Character</param>
+		/// <param name="name">the Name</param>
+		/// <returns>true when the whole Name matches</returns>
+		static bool glob(const std::string& pattern, const std::string& name);
+
+		/// <summary>
+		/// returns weather two Paths name the same File, when one is relative
+		/// to a Directory of the other. '\' and '/' are the same.
+		/// </summary>
+		/// <param name="a">the first Path</param>
+		/// <param name="b">the second Path</param>
+		/// <returns>true when the shorter Path is a trailing Part of the longer one</returns>
+		static bool samePath(const std::string& a, const std::string& b);
+	};
+
+}
+
+#endif
@@ -1,5 +1,7 @@
 #include "TestResults.h"
+#include "ReportQueue.h"
 #include <iomanip>
+#include <sstream>
 
 namespace Test {
 
@@ -7,10 +9,10 @@ namespace Test {
 	/// Creates a new Test Result
 	/// </summary>
 	/// <param name="code">the Code Segment</param>
-	/// <param name="file">the File with the Test</param>
-	/// <param name="line">the Line of the Test</param>
-	TestResultCollection::TestResult::TestResult(const utString& code, const char* file, size_t line)
-	: mCode(code), mFile(file), mLine(line) {}
+	/// <param name="location">the File and Line of the Test</param>
+	/// <param name="values">the formatted Values or nullptr</param>
+	TestResultCollection::TestResult::TestResult(const char* code, const SourceLocation& location, const char* values)
+	: mCode(code), mLocation(&location), mValues(values) {}
 
 
 	/// <summary>
@@ -22,19 +24,130 @@ namespace Test {
 			<< std::setw(indent) << std::left
 			<< "Condition: "	<< mCode << '\n'
 			<< std::setw(indent) << std::left
-			<< "in File: "	<< mFile << ':' << mLine << '\n';
+			<< "in File: "	<< mLocation->mFile << ':' << mLocation->mLine << '\n';
+		if (mValues)
+			stream << std::setw(indent) << std::left << "Values: " << mValues << '\n';
 	}
 
 
 
+	/// <summary>
+	/// Writes the Result to a Message. Code and Location are sent as Text,
+	/// a Worker that corrupted its Memory must not hand Pointers to the Parent.
+	/// </summary>
+	/// <param name="writer">the Message to write to</param>
+	void TestResultCollection::TestResult::save(MessageWriter& writer) const {
+		writer.writeString(mCode);
+		writer.writeString(mLocation->mFile);
+		writer.write(mLocation->mLine);
+		writer.write(mValues != nullptr);
+		if (mValues) writer.writeString(mValues);
+	}
+
+	/// <summary>
+	/// Reads a Result written by save and records it
+	/// </summary>
+	/// <param name="reader">the Message to read from</param>
+	/// <param name="collection">the Collection to record the Result in</param>
+	/// <returns>false when the Message is malformed</returns>
+	bool TestResultCollection::TestResult::load(MessageReader& reader, TestResultCollection& collection) {
+		std::string code, file;
+		uint32_t line;
+		bool hasValues;
+		if (!reader.readString(code) || !reader.readString(file) || !reader.read(line) || !reader.read(hasValues)) return false;
+
+		std::string values;
+		if (hasValues && !reader.readString(values)) return false;
+		collection.receive(code, file, line, hasValues ? &values : nullptr);
+		return true;
+	}
+
+
 	/// <summary>
 	/// Records a Fail of the Test
 	/// </summary>
+	/// <param name="code">the Code Segment with the Test, a String Literal</param>
+	/// <param name="location">the static Location of the Segment</param>
+	void TestResultCollection::fail(const char* code, const SourceLocation& location) {
+		if (isFull()) {
+			mFailCount++;
+			mOmitted++;
+			return;
+		}
+		append() = TestResult(code, location);
+		if (mOwner) ReportQueue::assertionFailed(mOwner, code, location, nullptr);
+	}
+
+	/// <summary>
+	/// Records a Fail of the Test together with the Values involved
+	/// </summary>
+	/// <param name="code">the Code Segment with the Test, a String Literal</param>
+	/// <param name="location">the static Location of the Segment</param>
+	/// <param name="values">the formatted Values, copied into the Arena</param>
+	void TestResultCollection::fail(const char* code, const SourceLocation& location, const std::string& values) {
+		if (isFull()) {
+			fail(code, location);
+			return;
+		}
+		const char* copy = mArena.copy(values.data(), values.size());
+		append() = TestResult(code, location, copy);
+		if (mOwner) ReportQueue::assertionFailed(mOwner, code, location, copy);
+	}
+
+	/// <summary>
+	/// Records a Fail read from another Process, Code and Location are copied into the Arena
+	/// </summary>
 	/// <param name="code">the Code Segment with the Test</param>
-	/// <param name="file">the File containing the Segment</param>
-	/// <param name="line">the Line with the Code Segment</param>
-	void TestResultCollection::fail(const utString& code, const char* file, size_t line) {
-		mResults.push_back(TestResult(code, file, line));
+	/// <param name="file">the File of the Segment</param>
+	/// <param name="line">the Line of the Segment</param>
+	/// <param name="values">the formatted Values or nullptr</param>
+	void TestResultCollection::receive(const std::string& code, const std::string& file, uint32_t line, const std::string* values) {
+		if (isFull()) {
+			mFailCount++;
+			mOmitted++;
+			return;
+		}
+
+		SourceLocation* location = static_cast<SourceLocation*>(mArena.allocate(sizeof(SourceLocation), alignof(SourceLocation)));
+		location->mFile = mArena.copy(file.data(), file.size());
+		location->mLine = line;
+		const char* copy = mArena.copy(code.data(), code.size());
+
+		if (values) fail(copy, *location, *values);
+		else fail(copy, *location);
+	}
+
+	/// <summary>
+	/// returns the Slot for the next Result, starting a new Block when needed
+	/// </summary>
+	/// <returns>the Slot to write the Result to</returns>
+	TestResultCollection::TestResult& TestResultCollection::append() {
+		if (!mLast || mLast->mCount == ResultBlock::mCapacity) {
+			ResultBlock* block = static_cast<ResultBlock*>(mArena.allocate(sizeof(ResultBlock), alignof(ResultBlock)));
+			block->mNext = nullptr;
+			block->mCount = 0;
+
+			if (mLast) mLast->mNext = block;
+			else mFirst = block;
+			mLast = block;
+		}
+
+		mFailCount++;
+		return mLast->mResults[mLast->mCount++];
+	}
+
+	/// <summary>
+	/// Forgets all Results, to run the Test again
+	/// </summary>
+	void TestResultCollection::clear() {
+		mArena.clear();
+		mFirst = mLast = nullptr;
+		mFailCount = 0;
+		mOmitted = 0;
+		mError.clear();
+		mTimedOut = false;
+		mAttempts = 1;
+		mRetryCause.clear();
 	}
 
 	/// <summary>
@@ -50,10 +163,46 @@ namespace Test {
 	/// </summary>
 	/// <param name="stream">the Stream to write to</param>
 	void TestResultCollection::reportFails(std::ostream& stream, uint32_t indent) const {
-		for (auto& result : mResults)
- 			result.report(stream, indent);
+		for (const ResultBlock* block = mFirst; block; block = block->mNext)
+			for (uint32_t i = 0; i < block->mCount; i++)
+				block->mResults[i].report(stream, indent);
+		if (mOmitted > 0)
+			stream << std::setw(indent) << std::left << "Omitted: " << mOmitted << " more Fails past the Limit\n";
+	}
+
+
+	/// <summary>
+	/// returns weather the Limit of stored Fails is reached. Further
+	/// Fails are only counted, so their Values needn't be formatted.
+	/// </summary>
+	/// <returns>true when no more Fails are stored</returns>
+	bool TestResultCollection::isFull() const {
+		return mLimit > 0 && mFailCount - mOmitted >= mLimit;
+	}
+
+	/// <summary>
+	/// Sets the Number of Fails that are stored, later ones are only counted
+	/// </summary>
+	/// <param name="limit">the Number of Fails, 0 for no Limit</param>
+	void TestResultCollection::setLimit(uint64_t limit) {
+		mLimit = limit;
 	}
 
+	/// <summary>
+	/// Returns the Number of Fails that are stored
+	/// </summary>
+	/// <returns>the Number of Fails, 0 for no Limit</returns>
+	uint64_t TestResultCollection::getLimit() const {
+		return mLimit;
+	}
+
+	/// <summary>
+	/// returns the Number of Fails that were counted but not stored
+	/// </summary>
+	/// <returns>the Number of omitted Fails</returns>
+	uint64_t TestResultCollection::omittedCount() const {
+		return mOmitted;
+	}
 
 	/// <summary>
 	/// Records an Escape from the Test Code, an Exception or a
@@ -61,7 +210,30 @@ namespace Test {
 	/// </summary>
 	/// <param name="err">the Error Message</param>
 	void TestResultCollection::error(const utString& err) {
-		mError = err;
+		//copied, a view of an exception message would outlive the exception
+		mError = std::string(err);
+	}
+
+	/// <summary>
+	/// Records that the Test ran longer than it was allowed to
+	/// </summary>
+	/// <param name="limit">the Time in Milliseconds after which it was stopped</param>
+	void TestResultCollection::timeout(double limit) {
+		std::ostringstream message;
+		message << "Timed out after " << limit << "ms";
+		mError = message.str();
+		mTimedOut = true;
+	}
+
+	/// <summary>
+	/// Records that the Test ran more than once because it failed,
+	/// the Results are those of the last Attempt
+	/// </summary>
+	/// <param name="attempts">the Number of Attempts</param>
+	/// <param name="cause">the Failure of the first Attempt</param>
+	void TestResultCollection::retried(uint32_t attempts, const std::string& cause) {
+		mAttempts = attempts;
+		mRetryCause = cause;
 	}
 
 	/// <summary>
@@ -69,7 +241,7 @@ namespace Test {
 	/// </summary>
 	/// <returns>the number of failed Tests</returns>
 	uint64_t TestResultCollection::failCount() const {
-		return mResults.size();
+		return mFailCount;
 	}
 	
 	/// <summary>
@@ -79,4 +251,93 @@ namespace Test {
 	bool TestResultCollection::hasError() const {
 		return !mError.empty();
 	}
-}
\ No newline at end of file
+
+	/// <summary>
+	/// returns weather the Test ran out of Time
+	/// </summary>
+	/// <returns>true when the Test timed out</returns>
+	bool TestResultCollection::hasTimedOut() const {
+		return mTimedOut;
+	}
+
+	/// <summary>
+	/// Returns how often the Test ran
+	/// </summary>
+	/// <returns>the Number of Attempts, 1 when it wasn't retried</returns>
+	uint32_t TestResultCollection::getAttempts() const {
+		return mAttempts;
+	}
+
+	/// <summary>
+	/// Returns the Failure of the first Attempt of a retried Test
+	/// </summary>
+	/// <returns>the Failure, empty when the Test wasn't retried</returns>
+	const std::string& TestResultCollection::getRetryCause() const {
+		return mRetryCause;
+	}
+
+	/// <summary>
+	/// returns weather the Test failed first and passed on a Retry
+	/// </summary>
+	/// <returns>true when the Test is flaky</returns>
+	bool TestResultCollection::isFlaky() const {
+		return mAttempts > 1 && mFailCount == 0 && mError.empty();
+	}
+
+	/// <summary>
+	/// returns the Error Message, empty when there was no Error
+	/// </summary>
+	/// <returns>the Error Message</returns>
+	const std::string& TestResultCollection::getError() const {
+		return mError;
+	}
+
+	/// <summary>
+	/// Sets the Test the Results belong to
+	/// </summary>
+	/// <param name="owner">the Test</param>
+	void TestResultCollection::setOwner(const Testable* owner) {
+		mOwner = owner;
+	}
+
+	/// <summary>
+	/// Writes all Results to a Message, so they can be sent to another Process
+	/// </summary>
+	/// <param name="writer">the Message to write to</param>
+	void TestResultCollection::save(MessageWriter& writer) const {
+		writer.write(mFailCount - mOmitted);
+		for (const ResultBlock* block = mFirst; block; block = block->mNext)
+			for (uint32_t i = 0; i < block->mCount; i++)
+				block->mResults[i].save(writer);
+		writer.writeString(mError);
+		writer.write(mTimedOut);
+		writer.write(mOmitted);
+		writer.write(mAttempts);
+		writer.writeString(mRetryCause);
+	}
+
+	/// <summary>
+	/// Appends the Results read from a Message written by save
+	/// </summary>
+	/// <param name="reader">the Message to read from</param>
+	/// <returns>false when the Message is malformed</returns>
+	bool TestResultCollection::load(MessageReader& reader) {
+		uint64_t count;
+		if (!reader.read(count)) return false;
+		for (uint64_t i = 0; i < count; i++)
+			if (!TestResult::load(reader, *this)) return false;
+
+		std::string err;
+		if (!reader.readString(err)) return false;
+		if (!err.empty()) mError = err;
+
+		bool timedOut;
+		uint64_t omitted;
+		if (!reader.read(timedOut) || !reader.read(omitted)) return false;
+		if (!reader.read(mAttempts) || !reader.readString(mRetryCause)) return false;
+		mTimedOut = mTimedOut || timedOut;
+		mFailCount += omitted;
+		mOmitted += omitted;
+		return true;
+	}
+}
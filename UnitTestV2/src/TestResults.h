@@ -2,28 +2,46 @@
 #ifndef UT_TEST_RESULTS_H
 #define UT_TEST_RESULTS_H
 #include "utCommon.h"
+#include "Arena.h"
+#include "Message.h"
 #include <cstdint>
 #include <ostream>
-#include <list>
+#include <string>
 
 namespace Test {
 
+	class Testable;
+
+	/// <summary>
+	/// Append only Record of the Results of a single Test.
+	/// Only the Thread running the Test writes to it, so no Synchronisation is needed.
+	/// Results are stored in Blocks inside a per Test Arena, recording one
+	/// doesn't allocate unless a Block is full.
+	/// </summary>
 	class TestResultCollection {
 	private: //internal Class
+		/// <summary>
+		/// A single failed Check. Code and Location have static Lifetime,
+		/// so only the Pointers are stored. Formatted Values, if any,
+		/// live in the Arena of the Collection.
+		/// </summary>
 		class TestResult {
+			friend TestResultCollection;
 		private:	//private Members
-			utString mCode;
-			utString mFile;
-			uint64_t mLine = 0;
+			const char* mCode;
+			const SourceLocation* mLocation;
+			const char* mValues;
 
 		public:		//Constructors and Destructors
+			TestResult() = default;
+
 			/// <summary>
 			/// Creates a new Test Result
 			/// </summary>
 			/// <param name="code">the Code Segment</param>
-			/// <param name="file">the File with the Test</param>
-			/// <param name="line">the Line of the Test</param>
-			explicit TestResult(const utString& code, const char* file, size_t line);
+			/// <param name="location">the File and Line of the Test</param>
+			/// <param name="values">the formatted Values or nullptr</param>
+			explicit TestResult(const char* code, const SourceLocation& location, const char* values = nullptr);
 
 		public:		//Functionality
 			/// <summary>
@@ -31,16 +49,62 @@ namespace Test {
 			/// </summary>
 			/// <param name="stream">the stream to write to</param>
 			void report(std::ostream& stream, uint32_t indent = 12) const;
+
+			/// <summary>
+			/// Writes the Result to a Message. Code and Location are sent as Text,
+			/// a Worker that corrupted its Memory must not hand Pointers to the Parent.
+			/// </summary>
+			/// <param name="writer">the Message to write to</param>
+			void save(MessageWriter& writer) const;
+
+			/// <summary>
+			/// Reads a Result written by save and records it
+			/// </summary>
+			/// <param name="reader">the Message to read from</param>
+			/// <param name="collection">the Collection to record the Result in</param>
+			/// <returns>false when the Message is malformed</returns>
+			static bool load(MessageReader& reader, TestResultCollection& collection);
 		};
 
-	private:	//internal Defines
-		typedef std::list<TestResult> result_collection;
-		typedef result_collection::iterator iterator;
-		typedef result_collection::const_iterator const_iterator;
+		/// <summary>
+		/// A fixed Number of Results, Blocks are chained in Order of Recording
+		/// </summary>
+		struct ResultBlock {
+			static constexpr uint32_t mCapacity = 64;
+
+			ResultBlock* mNext;
+			uint32_t mCount;
+			TestResult mResults[mCapacity];
+		};
+
+	private:	//internal Functionality
+		/// <summary>
+		/// returns the Slot for the next Result, starting a new Block when needed
+		/// </summary>
+		/// <returns>the Slot to write the Result to</returns>
+		TestResult& append();
+
+		/// <summary>
+		/// Records a Fail read from another Process, Code and Location are copied into the Arena
+		/// </summary>
+		/// <param name="code">the Code Segment with the Test</param>
+		/// <param name="file">the File of the Segment</param>
+		/// <param name="line">the Line of the Segment</param>
+		/// <param name="values">the formatted Values or nullptr</param>
+		void receive(const std::string& code, const std::string& file, uint32_t line, const std::string* values);
 
 	private:	//private Members
-		result_collection mResults;
-		utString mError;
+		Arena mArena;
+		ResultBlock* mFirst = nullptr;
+		ResultBlock* mLast = nullptr;
+		uint64_t mFailCount = 0;
+		uint64_t mOmitted = 0;
+		uint64_t mLimit = 0;
+		std::string mError;
+		bool mTimedOut = false;
+		uint32_t mAttempts = 1;
+		std::string mRetryCause;
+		const Testable* mOwner = nullptr;
 
 	public:		//Constructors and Destructors
 		/// <summary>
@@ -48,14 +112,29 @@ namespace Test {
 		/// </summary>
 		TestResultCollection() = default;
 
+		TestResultCollection(const TestResultCollection&) = delete;
+
 	public:		//exposed Functionality
 		/// <summary>
 		/// Records a Fail of the Test
 		/// </summary>
-		/// <param name="code">the Code Segment with the Test</param>
-		/// <param name="file">the File containing the Segment</param>
-		/// <param name="line">the Line with the Code Segment</param>
-		void fail(const utString& code, const char* file, size_t line);
+		/// <param name="code">the Code Segment with the Test, a String Literal</param>
+		/// <param name="location">the static Location of the Segment</param>
+		void fail(const char* code, const SourceLocation& location);
+
+		/// <summary>
+		/// Records a Fail of the Test together with the Values involved
+		/// </summary>
+		/// <param name="code">the Code Segment with the Test, a String Literal</param>
+		/// <param name="location">the static Location of the Segment</param>
+		/// <param name="values">the formatted Values, copied into the Arena</param>
+		void fail(const char* code, const SourceLocation& location, const std::string& values);
+
+		/// <summary>
+		/// Forgets all Results, to run the Test again. The Arena keeps
+		/// its newest Block, so the next Run records without allocating.
+		/// </summary>
+		void clear();
 
 		/// <summary>
 		/// Reports the Error that occured, if an error occured
@@ -70,6 +149,31 @@ namespace Test {
 		void reportFails(std::ostream& stream, uint32_t indent = 12) const;
 
 	public:		//Getters and Setters
+		/// <summary>
+		/// returns weather the Limit of stored Fails is reached. Further
+		/// Fails are only counted, so their Values needn't be formatted.
+		/// </summary>
+		/// <returns>true when no more Fails are stored</returns>
+		bool isFull() const;
+
+		/// <summary>
+		/// Sets the Number of Fails that are stored, later ones are only counted
+		/// </summary>
+		/// <param name="limit">the Number of Fails, 0 for no Limit</param>
+		void setLimit(uint64_t limit);
+
+		/// <summary>
+		/// Returns the Number of Fails that are stored
+		/// </summary>
+		/// <returns>the Number of Fails, 0 for no Limit</returns>
+		uint64_t getLimit() const;
+
+		/// <summary>
+		/// returns the Number of Fails that were counted but not stored
+		/// </summary>
+		/// <returns>the Number of omitted Fails</returns>
+		uint64_t omittedCount() const;
+
 		/// <summary>
 		/// Records an Escape from the Test Code, an Exception or a
 		/// Fail while running the init or cleanup functions
@@ -77,6 +181,20 @@ namespace Test {
 		/// <param name="err">the Error Message</param>
 		void error(const utString& err);
 
+		/// <summary>
+		/// Records that the Test ran longer than it was allowed to
+		/// </summary>
+		/// <param name="limit">the Time in Milliseconds after which it was stopped</param>
+		void timeout(double limit);
+
+		/// <summary>
+		/// Records that the Test ran more than once because it failed,
+		/// the Results are those of the last Attempt
+		/// </summary>
+		/// <param name="attempts">the Number of Attempts</param>
+		/// <param name="cause">the Failure of the first Attempt</param>
+		void retried(uint32_t attempts, const std::string& cause);
+
 		/// <summary>
 		/// returns the number of failed Tests
 		/// </summary>
@@ -88,6 +206,69 @@ namespace Test {
 		/// </summary>
 		/// <returns>true when an Error occured</returns>
 		bool hasError() const;
+
+		/// <summary>
+		/// returns weather the Test ran out of Time
+		/// </summary>
+		/// <returns>true when the Test timed out</returns>
+		bool hasTimedOut() const;
+
+		/// <summary>
+		/// Returns how often the Test ran
+		/// </summary>
+		/// <returns>the Number of Attempts, 1 when it wasn't retried</returns>
+		uint32_t getAttempts() const;
+
+		/// <summary>
+		/// Returns the Failure of the first Attempt of a retried Test
+		/// </summary>
+		/// <returns>the Failure, empty when the Test wasn't retried</returns>
+		const std::string& getRetryCause() const;
+
+		/// <summary>
+		/// returns weather the Test failed first and passed on a Retry
+		/// </summary>
+		/// <returns>true when the Test is flaky</returns>
+		bool isFlaky() const;
+
+		/// <summary>
+		/// returns the Error Message, empty when there was no Error
+		/// </summary>
+		/// <returns>the Error Message</returns>
+		const std::string& getError() const;
+
+		/// <summary>
+		/// Sets the Test the Results belong to, every Fail is then also
+		/// posted to the Reporters as it happens
+		/// </summary>
+		/// <param name="owner">the Test</param>
+		void setOwner(const Testable* owner);
+
+		/// <summary>
+		/// Calls a Function for every recorded Fail, in the Order they happened
+		/// </summary>
+		/// <param name="function">called with Code, Location and Values (nullptr when there are none)</param>
+		template<typename F>
+		void forEach(F&& function) const {
+			for (const ResultBlock* block = mFirst; block; block = block->mNext)
+				for (uint32_t i = 0; i < block->mCount; i++) {
+					const TestResult& result = block->mResults[i];
+					function(result.mCode, *result.mLocation, result.mValues);
+				}
+		}
+
+		/// <summary>
+		/// Writes all Results to a Message, so they can be sent to another Process
+		/// </summary>
+		/// <param name="writer">the Message to write to</param>
+		void save(MessageWriter& writer) const;
+
+		/// <summary>
+		/// Appends the Results read from a Message written by save
+		/// </summary>
+		/// <param name="reader">the Message to read from</param>
+		/// <returns>false when the Message is malformed</returns>
+		bool load(MessageReader& reader);
 	};
 
 }
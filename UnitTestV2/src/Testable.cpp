@@ -1,5 +1,7 @@
 #include "Testable.h"
 #include "TestCollection.h"
+#include "OutputCapture.h"
+#include "TestCase.h"
 
 namespace Test {
 	/// <summary>
@@ -8,7 +10,9 @@ namespace Test {
 	/// </summary>
 	/// <param name="name">the Name of the Test</param>
 	Testable::Testable(const std::string& name): mName(name) {
-		TestCollection::addTest(this);
+		mResult.setOwner(this);
+		//tests of a TEST_CASE are dispatched through their descriptor
+		if (!TestCase::isConstructing()) TestCollection::addTest(this);
 	}
 
 
@@ -18,9 +22,8 @@ namespace Test {
 	/// <returns>false when initialization failed. </return>
 	bool Testable::_init() {
 		try {
-			//backup cout and cin buffer and replace them with internal ones
-			mStdCoutBackup = std::cout.rdbuf(mCout.rdbuf());
-			mStdCinBackup = std::cin.rdbuf(mCin.rdbuf());
+			//redirect cout and cin of this thread to the internal buffers
+			OutputCapture::attach(mCout.rdbuf(), mCin.rdbuf());
 
 			mStartTime = clock::now();
 
@@ -33,8 +36,7 @@ namespace Test {
 		}
 
 		//restore original cout and cin buffer (because _init failed)
-		std::cout.rdbuf(mStdCoutBackup);
-		std::cin.rdbuf(mStdCinBackup);
+		OutputCapture::detach();
 
 		return false;
 	}
@@ -60,8 +62,7 @@ namespace Test {
 		try {
 			//restore original cout and cin buffer
 			if (!cleanup()) mResult.error("Failed to Cleanup Test");
-			std::cout.rdbuf(mStdCoutBackup);
-			std::cin.rdbuf(mStdCinBackup);
+			OutputCapture::detach();
 			mEndTime = clock::now();
 			mFinished = true;
 		} catch (std::exception& e) {
@@ -81,35 +82,42 @@ namespace Test {
 		return mResult.failCount() > 0;
 	}
 
+	/// <summary>
+	/// returns weather the Test was left running on a Thread after the
+	/// global Timeout expired
+	/// </summary>
+	/// <returns>true when the Test was abandoned</returns>
+	bool Testable::isAbandoned() const {
+		return mState.load() == Abandoned;
+	}
+
 
 	/// <summary>
 	/// Implements the Test Function to check for something being True
 	/// </summary>
 	/// <param name="value">the expression</param>
 	/// <param name="code">the line of Code being checked</param>
-	/// <param name="file">the file with the Line of Code</param>
-	/// <param name="line">the Line Number of the Line of Code</param>
-	void Testable::isTrue_impl(bool value, const char* code, const char* file, size_t line) {
-		if (!value) mResult.fail(code, file, line);
+	/// <param name="location">the File and Line of the Line of Code</param>
+	/// <returns>true when the Check passed</returns>
+	bool Testable::isTrue_impl(bool value, const char* code, const SourceLocation& location) {
+		if (!value) mResult.fail(code, location);
+		return value;
 	}
 
 	/// <summary>
-	/// Implements the Test Function to check for no Exception being thrown
+	/// Records a failed EXPECT_NEAR together with the Values and their Difference
 	/// </summary>
-	/// <param name="exp">the Function being tested</param>
-	/// <param name="code">the Line of Code being tested</param>
-	/// <param name="file">the File with the line of Code</param>
-	/// <param name="line">the Number of the Line of Code</param>
-	void Testable::noneThrown_impl(std::function<void()> exp, const char* code, const char* file, size_t line) {
-		try {
-			exp();
-		}
-		catch (...) {
-			mResult.fail(code, file, line);
-		}
+	/// <param name="a">the left Value</param>
+	/// <param name="b">the right Value</param>
+	/// <param name="epsilon">the largest allowed Difference</param>
+	/// <param name="code">the line of Code being checked</param>
+	/// <param name="location">the File and Line of the Line of Code</param>
+	void Testable::nearFailed(double a, double b, double epsilon, const char* code, const SourceLocation& location) {
+		if (mResult.isFull()) mResult.fail(code, location);
+		else mResult.fail(code, location,
+			stringify(a) + " vs " + stringify(b) + ", difference " + stringify(std::fabs(a - b)) + " > " + stringify(epsilon));
 	}
 
-
 	/// <summary>
 	/// Initializes the Test.
 	/// Everything to set up the Environment for the Test
@@ -126,6 +134,114 @@ namespace Test {
 	/// <returns>true on success</returns>
 	bool Testable::cleanup() { return true; }
 
+	/// <summary>
+	/// Tells, if the Test has to run alone.
+	/// Exclusive Tests run one after another, after all other Tests finished.
+	/// </summary>
+	/// <returns>true when the Test must not run in parallel</returns>
+	bool Testable::isExclusive() const { return false; }
+
+	/// <summary>
+	/// Writes additional Details of the Test to the Report
+	/// </summary>
+	/// <param name="stream">the stream to write to</param>
+	/// <param name="indent">the Width of the Labels</param>
+	void Testable::reportDetails(std::ostream&, uint32_t) const {}
+
+	/// <summary>
+	/// Moves the Test back to Idle, so a Worker can claim it again
+	/// </summary>
+	void Testable::rearm() {
+		mStop.store(false, std::memory_order_relaxed);
+		mState.store(Idle, std::memory_order_relaxed);
+	}
+
+	/// <summary>
+	/// Forgets the Outcome of the last Run, so the Test can run again
+	/// </summary>
+	void Testable::reset() {
+		mResult.clear();
+		mFinished = false;
+		mRegressed = false;
+		mBaseline = nullptr;
+		mCounters = PerfCounters::Values();
+		mAllocations = AllocationTracker::Statistics();
+		mCout.str(std::string());
+		mCout.clear();
+	}
+
+	/// <summary>
+	/// Writes the Outcome of the Test to a Message,
+	/// so a Test run in another Process can be reported here
+	/// </summary>
+	/// <param name="writer">the Message to write to</param>
+	void Testable::saveState(MessageWriter& writer) const {
+		//the clock is system wide, so time points stay comparable across processes
+		writer.write(mStartTime.time_since_epoch().count());
+		writer.write(mEndTime.time_since_epoch().count());
+		writer.write(mFinished);
+		writer.write(mCounters.mValues);
+		for (bool valid : mCounters.mValid)
+			writer.write(valid);
+		writer.write(mAllocations);
+		writer.writeString(mCout.str());
+		mResult.save(writer);
+	}
+
+	/// <summary>
+	/// Reads the Outcome of the Test from a Message written by saveState
+	/// </summary>
+	/// <param name="reader">the Message to read from</param>
+	/// <returns>false when the Message is malformed</returns>
+	bool Testable::loadState(MessageReader& reader) {
+		clock::rep start, end;
+		std::string output;
+		if (!reader.read(start) || !reader.read(end) || !reader.read(mFinished) || !reader.read(mCounters.mValues))
+			return false;
+		//flags are read one by one, so each byte is checked
+		for (bool& valid : mCounters.mValid)
+			if (!reader.read(valid)) return false;
+		if (!reader.read(mAllocations) || !reader.readString(output))
+			return false;
+
+		mStartTime = timepoint(clock::duration(start));
+		mEndTime = timepoint(clock::duration(end));
+		mCout.str(output);
+		return mResult.load(reader);
+	}
+
+	/// <summary>
+	/// Declares that the Test needs a Fixture
+	/// </summary>
+	/// <param name="fixture">the Fixture</param>
+	void Testable::uses(FixtureBase& fixture) {
+		mFixtures.push_back(&fixture);
+	}
+
+	/// <summary>
+	/// Adds a Tag to the Test, to select Tests with --tag and --exclude-tag
+	/// </summary>
+	/// <param name="name">the Name of the Tag</param>
+	void Testable::tag(const std::string& name) {
+		mTags.push_back(name);
+	}
+
+	/// <summary>
+	/// Declares a Source File the Test exercises
+	/// </summary>
+	/// <param name="file">the Path of the File, relative to the Root of the Project</param>
+	void Testable::covers(const std::string& file) {
+		mSources.push_back(file);
+	}
+
+	/// <summary>
+	/// Tells a long running Test to finish early
+	/// </summary>
+	/// <returns>true when the Test should stop</returns>
+	bool Testable::shouldStop() const {
+		return mStop.load(std::memory_order_relaxed);
+	}
+
 	/// <summary>
 	/// Getter for the Name of the Test
 	/// </summary>
@@ -134,6 +250,22 @@ namespace Test {
 		return mName;
 	}
 
+	/// <summary>
+	/// Returns the Tags of the Test
+	/// </summary>
+	/// <returns>the Tags</returns>
+	const std::vector<std::string>& Testable::getTags() const {
+		return mTags;
+	}
+
+	/// <summary>
+	/// Returns the Source Files the Test exercises
+	/// </summary>
+	/// <returns>the Paths of the Files</returns>
+	const std::vector<std::string>& Testable::getSources() const {
+		return mSources;
+	}
+
 	/// <summary>
 	/// Returns the Time the test took
 	/// </summary>
@@ -141,4 +273,95 @@ namespace Test {
 		if (!mFinished) return duration(0);
 		return mEndTime - mStartTime;
 	}
-}
+
+	/// <summary>
+	/// Returns the Timing compared against the Baseline
+	/// </summary>
+	/// <returns>the Duration in Milliseconds as a single Sample</returns>
+	Timing Testable::getTiming() const {
+		Timing timing;
+		timing.mMean = getTime().count();
+		timing.mSamples = 1;
+		return timing;
+	}
+
+	/// <summary>
+	/// Returns the Performance Counters recorded while the Test ran
+	/// </summary>
+	/// <returns>the Counters, all invalid when they weren't recorded</returns>
+	const PerfCounters::Values& Testable::getCounters() const {
+		return mCounters;
+	}
+
+	/// <summary>
+	/// Returns the Heap Allocations made by the Thread running the Test
+	/// </summary>
+	/// <returns>the Allocation Counters, all zero without UT_TRACK_ALLOCATIONS</returns>
+	const AllocationTracker::Statistics& Testable::getAllocations() const {
+		return mAllocations;
+	}
+
+	/// <summary>
+	/// Returns what the Test wrote to std::cout
+	/// </summary>
+	/// <returns>the captured Output</returns>
+	std::string Testable::getOutput() const {
+		return mCout.str();
+	}
+
+	/// <summary>
+	/// returns weather the Test got slower than its Baseline
+	/// </summary>
+	/// <returns>true when the Test is perf-regressed</returns>
+	bool Testable::isRegressed() const {
+		return mRegressed;
+	}
+
+	/// <summary>
+	/// Returns the Baseline Timing the Test was compared against
+	/// </summary>
+	/// <returns>the Baseline or nullptr when there is none</returns>
+	const Timing* Testable::getBaseline() const {
+		return mBaseline;
+	}
+
+	/// <summary>
+	/// Returns the Fails and Errors recorded by the Test
+	/// </summary>
+	/// <returns>the Results</returns>
+	const TestResultCollection& Testable::getResults() const {
+		return mResult;
+	}
+
+	/// <summary>
+	/// Sets the Time the Test may take
+	/// </summary>
+	/// <param name="milliseconds">the Time in Milliseconds, 0 for no Limit</param>
+	void Testable::setTimeout(double milliseconds) {
+		mTimeout = milliseconds;
+	}
+
+	/// <summary>
+	/// Returns the Time the Test may take
+	/// </summary>
+	/// <returns>the Time in Milliseconds, 0 for no Limit</returns>
+	double Testable::getTimeout() const {
+		return mTimeout;
+	}
+
+	/// <summary>
+	/// Sets the Number of Fails stored for the Report
+	/// </summary>
+	/// <param name="limit">the Number of Fails, 0 for no Limit</param>
+	void Testable::setFailLimit(uint64_t limit) {
+		mResult.setLimit(limit);
+	}
+
+	/// <summary>
+	/// Returns the Number of Fails stored for the Report
+	/// </summary>
+	/// <returns>the Number of Fails, 0 for no Limit</returns>
+	uint64_t Testable::getFailLimit() const {
+		return mResult.getLimit();
+	}
+}
\ No newline at end of file
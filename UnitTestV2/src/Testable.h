@@ -2,47 +2,147 @@
 #ifndef UT_TESTABLE_H
 #define UT_TESTABLE_H
 
-#include <functional>
+#include <atomic>
 #include <iostream>
 #include <sstream>
 #include <chrono>
+#include <cmath>
+#include <functional>
+#include <vector>
 #include "utCommon.h"
+#include "Stringify.h"
 #include "TestResults.h"
+#include "TimingDatabase.h"
+#include "PerfCounters.h"
+#include "AllocationTracker.h"
+#include "Fixture.h"
+
+#define EXPECT_VALID(exp) isTrue_impl(exp, "EXPECT_VALID: "#exp, UT_LOCATION)
+
+#define EXPECT_EQ(a,b) compare_impl(a, b, std::equal_to<>(), " == ", "EXPECT_EQ: "#a " == " #b, UT_LOCATION)
+
+#define EXPECT_NE(a,b) compare_impl(a, b, std::not_equal_to<>(), " != ", "EXPECT_NE: "#a " != " #b, UT_LOCATION)
 
-#define EXPECT_VALID(exp) isTrue_impl(exp, "EXPECT_VALID: "#exp, __FILENAME__, __LINE__)
+#define EXPECT_LT(a,b) compare_impl(a, b, std::less<>(), " < ", "EXPECT_LT: "#a " < " #b, UT_LOCATION)
 
-#define EXPECT_EQ(a,b) isTrue_impl((a==b), "EXPECT_EQ: "#a " == " #b, __FILENAME__, __LINE__)
+#define EXPECT_LE(a,b) compare_impl(a, b, std::less_equal<>(), " <= ", "EXPECT_LE: "#a " <= " #b, UT_LOCATION)
+
+#define EXPECT_GT(a,b) compare_impl(a, b, std::greater<>(), " > ", "EXPECT_GT: "#a " > " #b, UT_LOCATION)
+
+#define EXPECT_GE(a,b) compare_impl(a, b, std::greater_equal<>(), " >= ", "EXPECT_GE: "#a " >= " #b, UT_LOCATION)
+
+#define EXPECT_NEAR(a,b,epsilon) near_impl(a, b, epsilon, "EXPECT_NEAR: "#a " == " #b " +- " #epsilon, UT_LOCATION)
 
 #define EXPECT_EXCEPTION(exp, exc) wasThrown_impl<exc>(\
-			std::function<void()>([]()->void{exp;}),\
-			"EXPECT_EXCEPTION: "#exc" in "#exp, __FILENAME__,	__LINE__)
+			[&]()->void{exp;},\
+			"EXPECT_EXCEPTION: "#exc" in "#exp, UT_LOCATION)
 
 #define EXPECT_NO_EXCEPTION(exp) noneThrown_impl(\
-			std::function<void()>([]()->void{exp;}),\
-			"EXPECT_NO_EXCEPTION: "#exp, __FILENAME__, __LINE__)
+			[&]()->void{exp;},\
+			"EXPECT_NO_EXCEPTION: "#exp, UT_LOCATION)
+
+//the allocation Checks don't compile without UT_TRACK_ALLOCATIONS, a Check that can't count must not pass
+#define EXPECT_NO_ALLOC(exp) allocations_impl(\
+			[&]()->void{exp;}, 0,\
+			"EXPECT_NO_ALLOC: "#exp, UT_LOCATION)
+
+#define EXPECT_MAX_ALLOCS(exp, n) allocations_impl(\
+			[&]()->void{exp;}, n,\
+			"EXPECT_MAX_ALLOCS: "#exp" <= "#n, UT_LOCATION)
+
+//fatal Checks return from the calling Function when they fail, so they can only be
+//used in Functions returning void, like run. The Test still gets cleaned up.
+#define UT_FATAL(check) do { if (!(check)) return; } while (false)
+
+#define ASSERT_VALID(exp) UT_FATAL(isTrue_impl(exp, "ASSERT_VALID: "#exp, UT_LOCATION))
+
+#define ASSERT_EQ(a,b) UT_FATAL(compare_impl(a, b, std::equal_to<>(), " == ", "ASSERT_EQ: "#a " == " #b, UT_LOCATION))
+
+#define ASSERT_NE(a,b) UT_FATAL(compare_impl(a, b, std::not_equal_to<>(), " != ", "ASSERT_NE: "#a " != " #b, UT_LOCATION))
+
+#define ASSERT_LT(a,b) UT_FATAL(compare_impl(a, b, std::less<>(), " < ", "ASSERT_LT: "#a " < " #b, UT_LOCATION))
+
+#define ASSERT_LE(a,b) UT_FATAL(compare_impl(a, b, std::less_equal<>(), " <= ", "ASSERT_LE: "#a " <= " #b, UT_LOCATION))
+
+#define ASSERT_GT(a,b) UT_FATAL(compare_impl(a, b, std::greater<>(), " > ", "ASSERT_GT: "#a " > " #b, UT_LOCATION))
+
+#define ASSERT_GE(a,b) UT_FATAL(compare_impl(a, b, std::greater_equal<>(), " >= ", "ASSERT_GE: "#a " >= " #b, UT_LOCATION))
+
+#define ASSERT_NEAR(a,b,epsilon) UT_FATAL(near_impl(a, b, epsilon, "ASSERT_NEAR: "#a " == " #b " +- " #epsilon, UT_LOCATION))
+
+#define ASSERT_EXCEPTION(exp, exc) UT_FATAL(wasThrown_impl<exc>(\
+			[&]()->void{exp;},\
+			"ASSERT_EXCEPTION: "#exc" in "#exp, UT_LOCATION))
+
+#define ASSERT_NO_EXCEPTION(exp) UT_FATAL(noneThrown_impl(\
+			[&]()->void{exp;},\
+			"ASSERT_NO_EXCEPTION: "#exp, UT_LOCATION))
+
+#define ASSERT_NO_ALLOC(exp) UT_FATAL(allocations_impl(\
+			[&]()->void{exp;}, 0,\
+			"ASSERT_NO_ALLOC: "#exp, UT_LOCATION))
+
+#define ASSERT_MAX_ALLOCS(exp, n) UT_FATAL(allocations_impl(\
+			[&]()->void{exp;}, n,\
+			"ASSERT_MAX_ALLOCS: "#exp" <= "#n, UT_LOCATION))
 
 namespace Test {
 
 	class TestCollection;
+	class ProcessRunner;
+	class Watchdog;
+	class TextReporter;
+	class TestCase;
+	template<typename> class ParameterizedTestable;
+	template<typename...> class PropertyTestable;
 
 	class Testable {
 		friend TestCollection;
-	private:	//definitions
+		friend ProcessRunner;
+		friend Watchdog;
+		friend TextReporter;
+		template<typename> friend class ParameterizedTestable;
+		template<typename...> friend class PropertyTestable;
+		friend TestCase;
+	protected:	//definitions
 		typedef std::chrono::high_resolution_clock clock;
 		typedef std::chrono::time_point<clock> timepoint;
 		typedef std::chrono::duration<double, std::milli> duration;
 
+	private:	//internal Defines
+		/// <summary>
+		/// Progress of a Test on a Worker Thread. Only the Thread that moves
+		/// a Test out of Idle or Running may touch it afterwards.
+		/// </summary>
+		enum State {
+			Idle,
+			Running,
+			Done,
+			Skipped,
+			Abandoned
+		};
+
 	private:	//private Members
-		utString mName;
+		std::string mName;
 		TestResultCollection mResult;
 
 		timepoint mStartTime;
 		timepoint mEndTime;
 
-		std::basic_streambuf<char>* mStdCoutBackup = nullptr;
-		std::basic_streambuf<char>* mStdCinBackup = nullptr;
-
 		bool mFinished = false;
+		bool mRegressed = false;
+		const Timing* mBaseline = nullptr;
+
+		double mTimeout = 0;
+		std::atomic<bool> mStop{ false };
+		std::atomic<int> mState{ Idle };
+
+		PerfCounters::Values mCounters;
+		AllocationTracker::Statistics mAllocations;
+
+		std::vector<FixtureBase*> mFixtures;
+		std::vector<std::string> mTags;
+		std::vector<std::string> mSources;
 
 	protected:	//protected members
 		std::stringstream mCout;
@@ -56,6 +156,8 @@ namespace Test {
 		/// <param name="name">the Name of the Test</param>
 		Testable(const std::string& name);
 
+		virtual ~Testable() = default;
+
 	private:	//internal functionality
 		/// <summary>
 		/// init function wrapper
@@ -74,10 +176,9 @@ namespace Test {
 		void _cleanup();
 
 		/// <summary>
-		/// return, weather a test has failed yet
+		/// Moves the Test back to Idle, so a Worker can claim it again
 		/// </summary>
-		/// <returns>true when a test failed</returns>
-		bool hasFailed() const;
+		void rearm();
 
 	protected:	//Testing Functions
 		/// <summary>
@@ -85,38 +186,139 @@ namespace Test {
 		/// </summary>
 		/// <param name="value">the expression</param>
 		/// <param name="code">the line of Code being checked</param>
-		/// <param name="file">the file with the Line of Code</param>
-		/// <param name="line">the Line Number of the Line of Code</param>
-		void isTrue_impl(bool value, const char* code, const char* file, size_t line);
+		/// <param name="location">the File and Line of the Line of Code</param>
+		/// <returns>true when the Check passed</returns>
+		bool isTrue_impl(bool value, const char* code, const SourceLocation& location);
+
+		/// <summary>
+		/// Implements the Test Functions comparing two Values.
+		/// The Values are only formatted when the Comparison fails.
+		/// </summary>
+		/// <typeparam name="A">the Type of the left Value</typeparam>
+		/// <typeparam name="B">the Type of the right Value</typeparam>
+		/// <typeparam name="C">the Type of the Comparison</typeparam>
+		/// <param name="a">the left Value</param>
+		/// <param name="b">the right Value</param>
+		/// <param name="compare">the Comparison that has to hold</param>
+		/// <param name="op">the Operator shown between the Values</param>
+		/// <param name="code">the line of Code being checked</param>
+		/// <param name="location">the File and Line of the Line of Code</param>
+		/// <returns>true when the Check passed</returns>
+		template<typename A, typename B, typename C>
+		bool compare_impl(const A& a, const B& b, C compare, const char* op, const char* code, const SourceLocation& location) {
+			if (compare(a, b)) return true;
+			compareFailed(a, b, op, code, location);
+			return false;
+		}
+
+		/// <summary>
+		/// Records a failed Comparison together with both Values
+		/// </summary>
+		/// <typeparam name="A">the Type of the left Value</typeparam>
+		/// <typeparam name="B">the Type of the right Value</typeparam>
+		/// <param name="a">the left Value</param>
+		/// <param name="b">the right Value</param>
+		/// <param name="op">the Operator shown between the Values</param>
+		/// <param name="code">the line of Code being checked</param>
+		/// <param name="location">the File and Line of the Line of Code</param>
+		template<typename A, typename B>
+		UT_NOINLINE void compareFailed(const A& a, const B& b, const char* op, const char* code, const SourceLocation& location) {
+			if (mResult.isFull()) mResult.fail(code, location);
+			else mResult.fail(code, location, stringify(a) + op + stringify(b));
+		}
+
+		/// <summary>
+		/// Implements the Test Function to check two floating Point Values
+		/// for being at most epsilon apart. NaN is never near anything.
+		/// </summary>
+		/// <param name="a">the left Value</param>
+		/// <param name="b">the right Value</param>
+		/// <param name="epsilon">the largest allowed Difference</param>
+		/// <param name="code">the line of Code being checked</param>
+		/// <param name="location">the File and Line of the Line of Code</param>
+		/// <returns>true when the Check passed</returns>
+		bool near_impl(double a, double b, double epsilon, const char* code, const SourceLocation& location) {
+			if (std::fabs(a - b) <= epsilon) return true;
+			nearFailed(a, b, epsilon, code, location);
+			return false;
+		}
+
+		/// <summary>
+		/// Records a failed EXPECT_NEAR together with the Values and their Difference
+		/// </summary>
+		/// <param name="a">the left Value</param>
+		/// <param name="b">the right Value</param>
+		/// <param name="epsilon">the largest allowed Difference</param>
+		/// <param name="code">the line of Code being checked</param>
+		/// <param name="location">the File and Line of the Line of Code</param>
+		UT_NOINLINE void nearFailed(double a, double b, double epsilon, const char* code, const SourceLocation& location);
 
 		/// <summary>
 		/// Implements the Test Function to check if the correct Exception was thrown
 		/// </summary>
 		/// <typeparam name="E">the Exceptions Type</typeparam>
+		/// <typeparam name="F">the Type of the Callable</typeparam>
 		/// <param name="exp">the Function being tested</param>
 		/// <param name="code">the Line of Code being tested</param>
-		/// <param name="file">the File with the line of Code</param>
-		/// <param name="line">the Number of the Line of Code</param>
-		template<typename E>
-		void wasThrown_impl(std::function<void()> exp, const char* code, const char* file, size_t line) {
+		/// <param name="location">the File and Line of the Line of Code</param>
+		/// <returns>true when the Check passed</returns>
+		template<typename E, typename F>
+		bool wasThrown_impl(F&& exp, const char* code, const SourceLocation& location) {
 			try {
 				exp();
-				mResult.fail(code, file, line);
 			}
-			catch (E& e) { }
-			catch (...) {
-				mResult.fail(code, file, line);
+			catch (E&) {
+				return true;
 			}
+			catch (...) {}
+			mResult.fail(code, location);
+			return false;
 		}
 
 		/// <summary>
 		/// Implements the Test Function to check for no Exception being thrown
 		/// </summary>
+		/// <typeparam name="F">the Type of the Callable</typeparam>
 		/// <param name="exp">the Function being tested</param>
 		/// <param name="code">the Line of Code being tested</param>
-		/// <param name="file">the File with the line of Code</param>
-		/// <param name="line">the Number of the Line of Code</param>
-		void noneThrown_impl(std::function<void()> exp, const char* code, const char* file, size_t line);
+		/// <param name="location">the File and Line of the Line of Code</param>
+		/// <returns>true when the Check passed</returns>
+		template<typename F>
+		bool noneThrown_impl(F&& exp, const char* code, const SourceLocation& location) {
+			try {
+				exp();
+				return true;
+			}
+			catch (...) {
+				mResult.fail(code, location);
+				return false;
+			}
+		}
+
+		/// <summary>
+		/// Implements the Test Function to check how often an Expression allocates
+		/// </summary>
+		/// <typeparam name="F">the Type of the Callable</typeparam>
+		/// <param name="exp">the Function being tested</param>
+		/// <param name="limit">the Number of Allocations allowed</param>
+		/// <param name="code">the Line of Code being tested</param>
+		/// <param name="location">the File and Line of the Line of Code</param>
+		/// <returns>true when the Check passed</returns>
+		template<typename F>
+		bool allocations_impl(F&& exp, uint64_t limit, const char* code, const SourceLocation& location) {
+			//depends on F, so only a Check that is actually used fails to compile
+			static_assert(AllocationTracker::isEnabled() || sizeof(F) == 0,
+				"EXPECT_NO_ALLOC and EXPECT_MAX_ALLOCS need the Framework compiled with UT_TRACK_ALLOCATIONS");
+
+			uint64_t before = AllocationTracker::allocationCount();
+			exp();
+			uint64_t count = AllocationTracker::allocationCount() - before;
+			if (count <= limit) return true;
+
+			if (mResult.isFull()) mResult.fail(code, location);
+			else mResult.fail(code, location, std::to_string(count) + " allocations");
+			return false;
+		}
 
 	protected:		//protected functionality (to get overrides from childclasses)
 		
@@ -142,6 +344,69 @@ namespace Test {
 		/// </summary>
 		virtual void run() = 0;
 
+		/// <summary>
+		/// Tells, if the Test has to run alone.
+		/// Exclusive Tests run one after another, after all other Tests finished.
+		/// </summary>
+		/// <returns>true when the Test must not run in parallel</returns>
+		virtual bool isExclusive() const;
+
+		/// <summary>
+		/// Writes additional Details of the Test to the Report
+		/// </summary>
+		/// <param name="stream">the stream to write to</param>
+		/// <param name="indent">the Width of the Labels</param>
+		virtual void reportDetails(std::ostream& stream, uint32_t indent) const;
+
+		/// <summary>
+		/// Writes the Outcome of the Test to a Message,
+		/// so a Test run in another Process can be reported here
+		/// </summary>
+		/// <param name="writer">the Message to write to</param>
+		virtual void saveState(MessageWriter& writer) const;
+
+		/// <summary>
+		/// Reads the Outcome of the Test from a Message written by saveState
+		/// </summary>
+		/// <param name="reader">the Message to read from</param>
+		/// <returns>false when the Message is malformed</returns>
+		virtual bool loadState(MessageReader& reader);
+
+		/// <summary>
+		/// Forgets the Outcome of the last Run, so the Test can run again.
+		/// Also called between the Attempts of a retried Test, while it is
+		/// claimed by a Worker. Overrides have to call the Base Class.
+		/// </summary>
+		virtual void reset();
+
+		/// <summary>
+		/// Declares that the Test needs a Fixture. The Fixture is built before
+		/// the Test starts, outside of its Time, and stays until the Test finished.
+		/// </summary>
+		/// <param name="fixture">the Fixture</param>
+		void uses(FixtureBase& fixture);
+
+		/// <summary>
+		/// Adds a Tag to the Test, to select Tests with --tag and --exclude-tag
+		/// </summary>
+		/// <param name="name">the Name of the Tag</param>
+		void tag(const std::string& name);
+
+		/// <summary>
+		/// Declares a Source File the Test exercises. With --changed the Test only
+		/// runs when one of its Files changed; Tests without Files always run.
+		/// </summary>
+		/// <param name="file">the Path of the File, relative to the Root of the Project</param>
+		void covers(const std::string& file);
+
+		/// <summary>
+		/// Tells a long running Test to finish early.
+		/// Set when the Timeout of the Test or of the whole Run expired,
+		/// loops in run should check it and return when it is set.
+		/// </summary>
+		/// <returns>true when the Test should stop</returns>
+		bool shouldStop() const;
+
 	public:	//getters and setters
 		/// <summary>
 		/// Getter for the Name of the Test
@@ -149,10 +414,104 @@ namespace Test {
 		/// <returns>the Name of the Test</returns>
 		utString getName() const;
 
+		/// <summary>
+		/// Returns the Tags of the Test
+		/// </summary>
+		/// <returns>the Tags</returns>
+		const std::vector<std::string>& getTags() const;
+
+		/// <summary>
+		/// Returns the Source Files the Test exercises
+		/// </summary>
+		/// <returns>the Paths of the Files</returns>
+		const std::vector<std::string>& getSources() const;
+
 		/// <summary>
 		/// Returns the Time the test took
 		/// </summary>
 		duration getTime() const;
+
+		/// <summary>
+		/// Returns the Timing compared against the Baseline
+		/// </summary>
+		/// <returns>the Duration in Milliseconds as a single Sample</returns>
+		virtual Timing getTiming() const;
+
+		/// <summary>
+		/// Returns the Performance Counters recorded while the Test ran
+		/// </summary>
+		/// <returns>the Counters, all invalid when they weren't recorded</returns>
+		const PerfCounters::Values& getCounters() const;
+
+		/// <summary>
+		/// Returns the Heap Allocations made by the Thread running the Test
+		/// </summary>
+		/// <returns>the Allocation Counters, all zero without UT_TRACK_ALLOCATIONS</returns>
+		const AllocationTracker::Statistics& getAllocations() const;
+
+		/// <summary>
+		/// Returns what the Test wrote to std::cout
+		/// </summary>
+		/// <returns>the captured Output</returns>
+		std::string getOutput() const;
+
+		/// <summary>
+		/// return, weather a test has failed yet
+		/// </summary>
+		/// <returns>true when a test failed</returns>
+		bool hasFailed() const;
+
+		/// <summary>
+		/// returns weather the Test was left running on a Thread after the
+		/// global Timeout expired. Nothing but its Name may be read then.
+		/// </summary>
+		/// <returns>true when the Test was abandoned</returns>
+		bool isAbandoned() const;
+
+		/// <summary>
+		/// returns weather the Test got slower than its Baseline
+		/// </summary>
+		/// <returns>true when the Test is perf-regressed</returns>
+		bool isRegressed() const;
+
+		/// <summary>
+		/// Returns the Baseline Timing the Test was compared against
+		/// </summary>
+		/// <returns>the Baseline or nullptr when there is none</returns>
+		const Timing* getBaseline() const;
+
+		/// <summary>
+		/// Returns the Fails and Errors recorded by the Test
+		/// </summary>
+		/// <returns>the Results</returns>
+		const TestResultCollection& getResults() const;
+
+		/// <summary>
+		/// Sets the Time the Test may take. When it runs longer it fails as timed out.
+		/// A Test on a Thread is asked to stop through shouldStop, a Test in a
+		/// Worker Process is killed.
+		/// </summary>
+		/// <param name="milliseconds">the Time in Milliseconds, 0 for no Limit</param>
+		void setTimeout(double milliseconds);
+
+		/// <summary>
+		/// Returns the Time the Test may take
+		/// </summary>
+		/// <returns>the Time in Milliseconds, 0 for no Limit</returns>
+		double getTimeout() const;
+
+		/// <summary>
+		/// Sets the Number of Fails stored for the Report. Later Fails still
+		/// fail the Test and are counted, but aren't stored or formatted.
+		/// </summary>
+		/// <param name="limit">the Number of Fails, 0 for no Limit</param>
+		void setFailLimit(uint64_t limit);
+
+		/// <summary>
+		/// Returns the Number of Fails stored for the Report
+		/// </summary>
+		/// <returns>the Number of Fails, 0 for no Limit</returns>
+		uint64_t getFailLimit() const;
 	};
 
 }
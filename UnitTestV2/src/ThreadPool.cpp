@@ -0,0 +1,179 @@
+#include "ThreadPool.h"
+
+namespace Test {
+
+	/// <summary>
+	/// Creates the Pool and starts its Workers
+	/// </summary>
+	/// <param name="threads">the Number of Workers, 0 uses one per hardware Thread</param>
+	ThreadPool::ThreadPool(size_t threads) {
+		if (threads == 0) threads = defaultSize();
+
+		for (size_t i = 0; i < threads; i++)
+			mWorkers.push_back(std::make_unique<Worker>());
+
+		//start the threads only after all queues exist, they steal from each other
+		for (size_t i = 0; i < threads; i++)
+			mWorkers[i]->mThread = std::thread(&ThreadPool::work, this, i);
+	}
+
+	/// <summary>
+	/// Stops the Workers once all submitted Tasks are done
+	/// </summary>
+	ThreadPool::~ThreadPool() {
+		wait();
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mStopping = true;
+		}
+		mWake.notify_all();
+
+		for (auto& worker : mWorkers)
+			if (worker->mThread.joinable()) worker->mThread.join();
+	}
+
+	/// <summary>
+	/// Main Loop of a Worker
+	/// </summary>
+	/// <param name="index">the Index of the Worker</param>
+	void ThreadPool::work(size_t index) {
+		task job;
+		for (;;) {
+			if (pop(index, job) || steal(index, job)) {
+				job();
+				job = nullptr;
+
+				if (mPending.fetch_sub(1) == 1) {
+					std::lock_guard<std::mutex> lock(mMutex);
+					mDone.notify_all();
+				}
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(mMutex);
+			mWake.wait(lock, [this]() { return mStopping || mQueued > 0; });
+			if (mStopping && mQueued == 0) return;
+		}
+	}
+
+	/// <summary>
+	/// Takes the next Task from the front of the Workers own Queue
+	/// </summary>
+	/// <param name="index">the Index of the Worker</param>
+	/// <param name="out">receives the Task</param>
+	/// <returns>true when a Task was taken</returns>
+	bool ThreadPool::pop(size_t index, task& out) {
+		Worker& worker = *mWorkers[index];
+		std::lock_guard<std::mutex> lock(worker.mMutex);
+		if (worker.mQueue.empty()) return false;
+
+		out = std::move(worker.mQueue.front());
+		worker.mQueue.pop_front();
+		mQueued--;
+		return true;
+	}
+
+	/// <summary>
+	/// Takes a Task from the back of another Workers Queue
+	/// </summary>
+	/// <param name="index">the Index of the stealing Worker</param>
+	/// <param name="out">receives the Task</param>
+	/// <returns>true when a Task was stolen</returns>
+	bool ThreadPool::steal(size_t index, task& out) {
+		for (size_t i = 1; i < mWorkers.size(); i++) {
+			Worker& victim = *mWorkers[(index + i) % mWorkers.size()];
+			std::unique_lock<std::mutex> lock(victim.mMutex, std::try_to_lock);
+			if (!lock.owns_lock() || victim.mQueue.empty()) continue;
+
+			out = std::move(victim.mQueue.back());
+			victim.mQueue.pop_back();
+			mQueued--;
+			return true;
+		}
+		return false;
+	}
+
+	/// <summary>
+	/// Queues a Task on the next Worker (round robin)
+	/// </summary>
+	/// <param name="job">the Task to run</param>
+	void ThreadPool::submit(task job) {
+		submit(mNext++ % mWorkers.size(), std::move(job));
+	}
+
+	/// <summary>
+	/// Queues a Task on a specific Worker
+	/// </summary>
+	/// <param name="worker">the Index of the Worker</param>
+	/// <param name="job">the Task to run</param>
+	void ThreadPool::submit(size_t worker, task job) {
+		Worker& target = *mWorkers[worker % mWorkers.size()];
+		mPending++;
+		{
+			//publish under the pool mutex, so a worker about to sleep can't miss it
+			std::lock_guard<std::mutex> lock(mMutex);
+			mQueued++;
+		}
+		{
+			std::lock_guard<std::mutex> lock(target.mMutex);
+			target.mQueue.push_back(std::move(job));
+		}
+		mWake.notify_one();
+	}
+
+	/// <summary>
+	/// Blocks until every submitted Task has finished
+	/// </summary>
+	void ThreadPool::wait() {
+		std::unique_lock<std::mutex> lock(mMutex);
+		mDone.wait(lock, [this]() { return mPending == 0; });
+	}
+
+	/// <summary>
+	/// Blocks until every submitted Task has finished or the Deadline passed
+	/// </summary>
+	/// <param name="deadline">the Time to give up waiting</param>
+	/// <returns>false when the Deadline passed first</returns>
+	bool ThreadPool::waitUntil(std::chrono::steady_clock::time_point deadline) {
+		std::unique_lock<std::mutex> lock(mMutex);
+		return mDone.wait_until(lock, deadline, [this]() { return mPending == 0; });
+	}
+
+	/// <summary>
+	/// Drops all queued Tasks and detaches the Workers
+	/// </summary>
+	void ThreadPool::abandon() {
+		for (auto& worker : mWorkers) {
+			std::lock_guard<std::mutex> lock(worker->mMutex);
+			mQueued -= worker->mQueue.size();
+			mPending -= worker->mQueue.size();
+			worker->mQueue.clear();
+		}
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mStopping = true;
+		}
+		mWake.notify_all();
+
+		//idle workers exit now, busy ones after their task returns, if ever
+		for (auto& worker : mWorkers)
+			worker->mThread.detach();
+	}
+
+	/// <summary>
+	/// returns the Number of Workers
+	/// </summary>
+	/// <returns>the Number of Workers</returns>
+	size_t ThreadPool::size() const {
+		return mWorkers.size();
+	}
+
+	/// <summary>
+	/// returns the Number of Workers used when none are specified
+	/// </summary>
+	/// <returns>the Number of hardware Threads, at least 1</returns>
+	size_t ThreadPool::defaultSize() {
+		size_t threads = std::thread::hardware_concurrency();
+		return threads > 0 ? threads : 1;
+	}
+}
@@ -0,0 +1,135 @@
+#pragma once
+#ifndef UT_THREAD_POOL_H
+#define UT_THREAD_POOL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Test {
+
+	/// <summary>
+	/// Fixed size Pool of Worker Threads.
+	/// Every Worker owns a Queue of Tasks, idle Workers steal
+	/// Tasks from the back of the other Workers Queues.
+	/// </summary>
+	class ThreadPool {
+	public:		//exposed Defines
+		typedef std::function<void()> task;
+
+	private:	//internal Class
+		/// <summary>
+		/// A Worker Thread with its own Task Queue
+		/// </summary>
+		class Worker {
+		public:		//public Members
+			std::deque<task> mQueue;
+			std::mutex mMutex;
+			std::thread mThread;
+		};
+
+	private:	//private Members
+		std::vector<std::unique_ptr<Worker>> mWorkers;
+
+		std::mutex mMutex;
+		std::condition_variable mWake;
+		std::condition_variable mDone;
+
+		std::atomic<size_t> mQueued{ 0 };
+		std::atomic<size_t> mPending{ 0 };
+		std::atomic<size_t> mNext{ 0 };
+
+		bool mStopping = false;
+
+	public:		//Constructors and Destructors
+		/// <summary>
+		/// Creates the Pool and starts its Workers
+		/// </summary>
+		/// <param name="threads">the Number of Workers, 0 uses one per hardware Thread</param>
+		explicit ThreadPool(size_t threads = 0);
+
+		ThreadPool(const ThreadPool&) = delete;
+
+		/// <summary>
+		/// Stops the Workers once all submitted Tasks are done
+		/// </summary>
+		~ThreadPool();
+
+	private:	//internal Functionality
+		/// <summary>
+		/// Main Loop of a Worker
+		/// </summary>
+		/// <param name="index">the Index of the Worker</param>
+		void work(size_t index);
+
+		/// <summary>
+		/// Takes the next Task from the front of the Workers own Queue
+		/// </summary>
+		/// <param name="index">the Index of the Worker</param>
+		/// <param name="out">receives the Task</param>
+		/// <returns>true when a Task was taken</returns>
+		bool pop(size_t index, task& out);
+
+		/// <summary>
+		/// Takes a Task from the back of another Workers Queue
+		/// </summary>
+		/// <param name="index">the Index of the stealing Worker</param>
+		/// <param name="out">receives the Task</param>
+		/// <returns>true when a Task was stolen</returns>
+		bool steal(size_t index, task& out);
+
+	public:		//exposed Functionality
+		/// <summary>
+		/// Queues a Task on the next Worker (round robin)
+		/// </summary>
+		/// <param name="job">the Task to run</param>
+		void submit(task job);
+
+		/// <summary>
+		/// Queues a Task on a specific Worker
+		/// </summary>
+		/// <param name="worker">the Index of the Worker</param>
+		/// <param name="job">the Task to run</param>
+		void submit(size_t worker, task job);
+
+		/// <summary>
+		/// Blocks until every submitted Task has finished
+		/// </summary>
+		void wait();
+
+		/// <summary>
+		/// Blocks until every submitted Task has finished or the Deadline passed
+		/// </summary>
+		/// <param name="deadline">the Time to give up waiting</param>
+		/// <returns>false when the Deadline passed first</returns>
+		bool waitUntil(std::chrono::steady_clock::time_point deadline);
+
+		/// <summary>
+		/// Drops all queued Tasks and detaches the Workers, so a Task that never
+		/// returns can't block the Caller. The Workers keep using the Pool,
+		/// so it must not be destroyed afterwards and is leaked on purpose.
+		/// </summary>
+		void abandon();
+
+		/// <summary>
+		/// returns the Number of Workers
+		/// </summary>
+		/// <returns>the Number of Workers</returns>
+		size_t size() const;
+
+		/// <summary>
+		/// returns the Number of Workers used when none are specified
+		/// </summary>
+		/// <returns>the Number of hardware Threads, at least 1</returns>
+		static size_t defaultSize();
+	};
+
+}
+
+#endif
@@ -0,0 +1,136 @@
+#include "TimingDatabase.h"
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+namespace Test {
+
+	namespace {
+		/// <summary>
+		/// one sided 95% Quantiles of Student's t-Distribution for 1 to 30 Degrees of Freedom
+		/// </summary>
+		constexpr double gStudentT95[] = {
+			6.314, 2.920, 2.353, 2.132, 2.015, 1.943, 1.895, 1.860, 1.833, 1.812,
+			1.796, 1.782, 1.771, 1.761, 1.753, 1.746, 1.740, 1.734, 1.729, 1.725,
+			1.721, 1.717, 1.714, 1.711, 1.708, 1.706, 1.703, 1.701, 1.699, 1.697
+		};
+
+		/// <summary>
+		/// returns the critical t Value for the given Degrees of Freedom
+		/// </summary>
+		double criticalT(double freedom) {
+			if (freedom < 1) freedom = 1;
+			if (freedom > 30) return 1.645;
+			return gStudentT95[static_cast<size_t>(freedom) - 1];
+		}
+	}
+
+
+	/// <summary>
+	/// Replaces the Content with the Timings stored in a File
+	/// </summary>
+	/// <param name="path">the File to read</param>
+	/// <returns>false when the File could not be read</returns>
+	bool TimingDatabase::load(const std::string& path) {
+		std::ifstream stream(path);
+		if (!stream) return false;
+
+		mTimings.clear();
+		std::string line;
+		while (std::getline(stream, line)) {
+			if (line.empty() || line[0] == '#') continue;
+
+			//name, mean, stddev, samples; further columns are informational
+			std::istringstream fields(line);
+			std::string name, mean, stddev, samples;
+			if (!std::getline(fields, name, '\t') || !std::getline(fields, mean, '\t')
+				|| !std::getline(fields, stddev, '\t') || !std::getline(fields, samples, '\t')) continue;
+
+			try {
+				Timing timing;
+				timing.mMean = std::stod(mean);
+				timing.mStdDev = std::stod(stddev);
+				timing.mSamples = std::stoull(samples);
+				mTimings[name] = timing;
+			} catch (std::exception&) {
+				continue;
+			}
+		}
+		return true;
+	}
+
+	/// <summary>
+	/// Writes all Timings to a File
+	/// </summary>
+	/// <param name="path">the File to write</param>
+	/// <returns>false when the File could not be written</returns>
+	bool TimingDatabase::save(const std::string& path) const {
+		std::ofstream stream(path);
+		if (!stream) return false;
+
+		stream.precision(17);
+		stream << "# name\tmean\tstddev\tsamples\n";
+		for (auto& entry : mTimings)
+			stream << entry.first << '\t' << entry.second.mMean << '\t'
+			<< entry.second.mStdDev << '\t' << entry.second.mSamples << '\n';
+
+		return static_cast<bool>(stream);
+	}
+
+	/// <summary>
+	/// Sets the Timing of a Test
+	/// </summary>
+	/// <param name="name">the Name of the Test</param>
+	/// <param name="timing">the Timing</param>
+	void TimingDatabase::set(const std::string& name, const Timing& timing) {
+		mTimings[name] = timing;
+	}
+
+	/// <summary>
+	/// Looks up the Timing of a Test
+	/// </summary>
+	/// <param name="name">the Name of the Test</param>
+	/// <returns>the Timing or nullptr when the Test is unknown</returns>
+	const Timing* TimingDatabase::find(const std::string& name) const {
+		auto entry = mTimings.find(name);
+		return entry == mTimings.end() ? nullptr : &entry->second;
+	}
+
+	/// <summary>
+	/// returns weather the Database holds no Timings
+	/// </summary>
+	/// <returns>true when empty</returns>
+	bool TimingDatabase::empty() const {
+		return mTimings.empty();
+	}
+
+	/// <summary>
+	/// Compares a Timing against its Baseline. It is a Regression when it is slower
+	/// than the Tolerance allows and, if both have several Samples, a one sided
+	/// Welch t-Test shows the Difference is significant (p &lt; 0.05).
+	/// </summary>
+	/// <param name="current">the Timing of this Run</param>
+	/// <param name="baseline">the stored Timing</param>
+	/// <param name="tolerance">the allowed relative Slowdown, 0.1 is 10%</param>
+	/// <param name="minimum">the smallest absolute Slowdown counted for single Samples</param>
+	/// <returns>true when the Timing regressed</returns>
+	bool TimingDatabase::isRegression(const Timing& current, const Timing& baseline, double tolerance, double minimum) {
+		double difference = current.mMean - baseline.mMean;
+		if (difference <= baseline.mMean * tolerance) return false;
+
+		if (current.mSamples < 2 || baseline.mSamples < 2)
+			return difference >= minimum;
+
+		double currentError = current.mStdDev * current.mStdDev / current.mSamples;
+		double baselineError = baseline.mStdDev * baseline.mStdDev / baseline.mSamples;
+		double error = currentError + baselineError;
+		if (error <= 0) return true;
+
+		//Welch-Satterthwaite approximation of the degrees of freedom
+		double freedom = error * error / (
+			currentError * currentError / (current.mSamples - 1) +
+			baselineError * baselineError / (baseline.mSamples - 1));
+
+		return difference / std::sqrt(error) > criticalT(freedom);
+	}
+}
@@ -0,0 +1,88 @@
+#pragma once
+#ifndef UT_TIMING_DATABASE_H
+#define UT_TIMING_DATABASE_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace Test {
+
+	/// <summary>
+	/// Timing of a Test: Milliseconds for plain Tests, the median
+	/// Nanoseconds per Iteration for Benchmarks
+	/// </summary>
+	struct Timing {
+		double mMean = 0;
+		double mStdDev = 0;
+		uint64_t mSamples = 0;
+	};
+
+	/// <summary>
+	/// Timings of Tests by Name, stored as a tab separated Text File
+	/// so it can be kept as a Baseline and compared against later
+	/// </summary>
+	class TimingDatabase {
+	private:	//internal Defines
+		typedef std::map<std::string, Timing> timing_collection;
+
+	private:	//private Members
+		timing_collection mTimings;
+
+	public:		//Constructors and Destructors
+		/// <summary>
+		/// Creates an empty Database
+		/// </summary>
+		TimingDatabase() = default;
+
+	public:		//exposed Functionality
+		/// <summary>
+		/// Replaces the Content with the Timings stored in a File
+		/// </summary>
+		/// <param name="path">the File to read</param>
+		/// <returns>false when the File could not be read</returns>
+		bool load(const std::string& path);
+
+		/// <summary>
+		/// Writes all Timings to a File
+		/// </summary>
+		/// <param name="path">the File to write</param>
+		/// <returns>false when the File could not be written</returns>
+		bool save(const std::string& path) const;
+
+		/// <summary>
+		/// Sets the Timing of a Test
+		/// </summary>
+		/// <param name="name">the Name of the Test</param>
+		/// <param name="timing">the Timing</param>
+		void set(const std::string& name, const Timing& timing);
+
+		/// <summary>
+		/// Looks up the Timing of a Test
+		/// </summary>
+		/// <param name="name">the Name of the Test</param>
+		/// <returns>the Timing or nullptr when the Test is unknown</returns>
+		const Timing* find(const std::string& name) const;
+
+		/// <summary>
+		/// returns weather the Database holds no Timings
+		/// </summary>
+		/// <returns>true when empty</returns>
+		bool empty() const;
+
+		/// <summary>
+		/// Compares a Timing against its Baseline. It is a Regression when it is slower
+		/// than the Tolerance allows and, if both have several Samples, a one sided
+		/// Welch t-Test shows the Difference is significant (p &lt; 0.05).
+		/// </summary>
+		/// <param name="current">the Timing of this Run</param>
+		/// <param name="baseline">the stored Timing</param>
+		/// <param name="tolerance">the allowed relative Slowdown, 0.1 is 10%</param>
+		/// <param name="minimum">the smallest absolute Slowdown counted for single Samples</param>
+		/// <returns>true when the Timing regressed</returns>
+		static bool isRegression(const Timing& current, const Timing& baseline, double tolerance, double minimum);
+	};
+
+}
+
+#endif
@@ -4,5 +4,12 @@
 
 #include "TestCollection.h"
 #include "Testable.h"
+#include "TestCase.h"
+#include "Benchmark.h"
+#include "ParameterizedTestable.h"
+#include "PropertyTestable.h"
+#include "DataFile.h"
+#include "JUnitReporter.h"
+#include "JsonReporter.h"
 
 #endif
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include "Watchdog.h"
+
+namespace Test {
+
+	/// <summary>
+	/// Starts the Watchdog Thread
+	/// </summary>
+	Watchdog::Watchdog() : mThread(&Watchdog::watch, this) {}
+
+	/// <summary>
+	/// Stops the Watchdog Thread
+	/// </summary>
+	Watchdog::~Watchdog() {
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mStopping = true;
+		}
+		mWake.notify_all();
+		mThread.join();
+	}
+
+	/// <summary>
+	/// Main Loop of the Watchdog Thread
+	/// </summary>
+	void Watchdog::watch() {
+		std::unique_lock<std::mutex> lock(mMutex);
+		while (!mStopping) {
+			if (mDeadlines.empty()) {
+				mWake.wait(lock);
+				continue;
+			}
+
+			auto next = mDeadlines.begin();
+			if (clock::now() < next->first) {
+				//woken early when an earlier deadline is armed
+				mWake.wait_until(lock, next->first);
+				continue;
+			}
+
+			next->second->mStop.store(true, std::memory_order_relaxed);
+			mDeadlines.erase(next);
+		}
+	}
+
+	/// <summary>
+	/// Starts watching a Test
+	/// </summary>
+	/// <param name="test">the Test that just started</param>
+	/// <param name="timeout">the Time in Milliseconds the Test may take</param>
+	void Watchdog::arm(Testable* test, double timeout) {
+		clock::time_point deadline = clock::now()
+			+ std::chrono::duration_cast<clock::duration>(std::chrono::duration<double, std::milli>(timeout));
+
+		bool earliest;
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			auto entry = mDeadlines.emplace(deadline, test);
+			earliest = entry == mDeadlines.begin();
+		}
+		if (earliest) mWake.notify_one();
+	}
+
+	/// <summary>
+	/// Stops watching a Test
+	/// </summary>
+	/// <param name="test">the Test that finished</param>
+	void Watchdog::disarm(Testable* test) {
+		//only the running tests are armed, so the scan stays short
+		std::lock_guard<std::mutex> lock(mMutex);
+		for (auto entry = mDeadlines.begin(); entry != mDeadlines.end(); ++entry)
+			if (entry->second == test) {
+				mDeadlines.erase(entry);
+				return;
+			}
+	}
+}
@@ -0,0 +1,69 @@
+#pragma once
+#ifndef UT_WATCHDOG_H
+#define UT_WATCHDOG_H
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include "Testable.h"
+
+namespace Test {
+
+	/// <summary>
+	/// Watches the Timeouts of Tests running on Worker Threads.
+	/// A Thread can't be killed, so a Test that runs past its Deadline is
+	/// only asked to stop through Testable::shouldStop.
+	/// </summary>
+	class Watchdog {
+	public:		//exposed Defines
+		typedef std::chrono::steady_clock clock;
+		typedef std::multimap<clock::time_point, Testable*> deadline_collection;
+
+	private:	//private Members
+		deadline_collection mDeadlines;
+
+		std::mutex mMutex;
+		std::condition_variable mWake;
+		bool mStopping = false;
+
+		std::thread mThread;
+
+	public:		//Constructors and Destructors
+		/// <summary>
+		/// Starts the Watchdog Thread
+		/// </summary>
+		Watchdog();
+
+		Watchdog(const Watchdog&) = delete;
+
+		/// <summary>
+		/// Stops the Watchdog Thread
+		/// </summary>
+		~Watchdog();
+
+	private:	//internal Functionality
+		/// <summary>
+		/// Main Loop of the Watchdog Thread
+		/// </summary>
+		void watch();
+
+	public:		//exposed Functionality
+		/// <summary>
+		/// Starts watching a Test
+		/// </summary>
+		/// <param name="test">the Test that just started</param>
+		/// <param name="timeout">the Time in Milliseconds the Test may take</param>
+		void arm(Testable* test, double timeout);
+
+		/// <summary>
+		/// Stops watching a Test
+		/// </summary>
+		/// <param name="test">the Test that finished</param>
+		void disarm(Testable* test);
+	};
+
+}
+
+#endif
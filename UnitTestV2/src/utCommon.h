@@ -7,10 +7,34 @@
 #include <string>
 #endif
 
-#if defined(__WIN32) or defined(WIN32)
-#define __FILENAME__ (strrchr(__FILE__, '\\') ? strrchr(__FILE__, '\\') + 1 : __FILE__)
+#include <cstdint>
+
+#if __cplusplus > 201703L && __has_include(<source_location>)
+#include <source_location>
+#endif
+
+//name of the current file without its directory, resolved at compile time
+#define __FILENAME__ ([]() -> const char* {\
+			constexpr const char* name = ::Test::fileName(__FILE__);\
+			return name; }())
+
+//reference to a static SourceLocation of the current line, built at compile time
+#if defined(__cpp_lib_source_location)
+#define UT_LOCATION ([]() -> const ::Test::SourceLocation& {\
+			static constexpr std::source_location source = std::source_location::current();\
+			static constexpr ::Test::SourceLocation location{ ::Test::fileName(source.file_name()), source.line() };\
+			return location; }())
 #else
-#define __FILENAME__ (strrchr(__FILE__, '/') ? strrchr(__FILE__, '/') + 1 : __FILE__)
+#define UT_LOCATION ([]() -> const ::Test::SourceLocation& {\
+			static constexpr ::Test::SourceLocation location{ ::Test::fileName(__FILE__), __LINE__ };\
+			return location; }())
+#endif
+
+//keeps the Failure Path of a Check out of the Code of the Test
+#if defined(_MSC_VER)
+#define UT_NOINLINE __declspec(noinline)
+#else
+#define UT_NOINLINE __attribute__((noinline, cold))
 #endif
 
 namespace Test {
@@ -19,6 +43,26 @@ namespace Test {
 	#else
 	using utString = std::string;
 	#endif
+
+	/// <summary>
+	/// File and Line of a Check, both known at Compile Time
+	/// </summary>
+	struct SourceLocation {
+		const char* mFile;
+		uint32_t mLine;
+	};
+
+	/// <summary>
+	/// returns the Part of a Path after the last Directory Separator
+	/// </summary>
+	/// <param name="path">the Path</param>
+	/// <returns>a Pointer into the Path to the File Name</returns>
+	constexpr const char* fileName(const char* path) {
+		const char* name = path;
+		for (const char* c = path; *c; c++)
+			if (*c == '/' || *c == '\\') name = c + 1;
+		return name;
+	}
 }
 
 #endif
\ No newline at end of file
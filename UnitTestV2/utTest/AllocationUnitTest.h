@@ -0,0 +1,17 @@
+#pragma once
+#include "../src/UnitTest.h"
+#include <vector>
+#include "factorial.h"
+
+//the checks only mean something when allocations are counted
+#if defined(UT_TRACK_ALLOCATIONS)
+COVERING_TEST_CASE(UT_Allocation, "Allocation Test", "", 0, "utTest/factorial.cpp") {
+	EXPECT_NO_ALLOC(factorial(10));
+
+	std::vector<int32_t> values;
+	values.reserve(16);
+	EXPECT_NO_ALLOC(values.push_back(factorial(5)));
+
+	EXPECT_MAX_ALLOCS(std::vector<int32_t>(100, 1), 1);
+}
+#endif
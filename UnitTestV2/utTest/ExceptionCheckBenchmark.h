@@ -0,0 +1,34 @@
+#pragma once
+#include "../src/UnitTest.h"
+#include <functional>
+#include "factorial.h"
+
+class BM_ExceptionCheckFunction : public Test::Benchmark {
+public:
+	BM_ExceptionCheckFunction() : Benchmark("EXPECT_NO_EXCEPTION std::function") {};
+
+protected:
+	void measure(uint64_t iterations) override {
+		int32_t number = 1;
+		for (uint64_t i = 0; i < iterations; i++) {
+			Test::doNotOptimize(number);
+			//the check as it was before: type erased and passed by value
+			noneThrown_impl(std::function<void()>([&]()->void { Test::doNotOptimize(factorial(number)); }),
+				"EXPECT_NO_EXCEPTION: factorial(number)", UT_LOCATION);
+		}
+	}
+};
+
+class BM_ExceptionCheckTemplate : public Test::Benchmark {
+public:
+	BM_ExceptionCheckTemplate() : Benchmark("EXPECT_NO_EXCEPTION template") {};
+
+protected:
+	void measure(uint64_t iterations) override {
+		int32_t number = 1;
+		for (uint64_t i = 0; i < iterations; i++) {
+			Test::doNotOptimize(number);
+			EXPECT_NO_EXCEPTION(Test::doNotOptimize(factorial(number)));
+		}
+	}
+};
@@ -4,7 +4,10 @@
 
 class UT_Factorial : public Test::Testable {
 public:
-	UT_Factorial() : Testable("Factorial Test") {};
+	UT_Factorial() : Testable("Factorial Test") {
+		tag("math");
+		covers("utTest/factorial.cpp");
+	};
 
 protected:
 	void run() override {
@@ -4,7 +4,10 @@
 
 class UT_Fibonacci : public Test::Testable {
 public:
-	UT_Fibonacci() : Testable("Fibonacci Test") {};
+	UT_Fibonacci() : Testable("Fibonacci Test") {
+		tag("math");
+		covers("utTest/fibonacci.cpp");
+	};
 
 protected:
 	void run() override {
@@ -0,0 +1,43 @@
+#pragma once
+#include "../src/UnitTest.h"
+#include "fibonacci.h"
+#include <vector>
+
+typedef Test::Fixture<std::vector<int64_t>> FibonacciNumbers;
+
+inline std::unique_ptr<std::vector<int64_t>> computeFibonacciNumbers() {
+	std::unique_ptr<std::vector<int64_t>> numbers(new std::vector<int64_t>());
+	for (int64_t i = 0; i <= 30; i++) numbers->push_back(fibonacci(i));
+	return numbers;
+}
+
+class UT_FibonacciGrowth : public Test::Testable {
+	const FibonacciNumbers& mNumbers;
+
+public:
+	UT_FibonacciGrowth(FibonacciNumbers& numbers) : Testable("Fibonacci Growth"), mNumbers(numbers) {
+		uses(numbers);
+	}
+
+protected:
+	void run() override {
+		for (size_t i = 2; i < mNumbers->size(); i++)
+			EXPECT_EQ(mNumbers.get()[i], mNumbers.get()[i - 1] + mNumbers.get()[i - 2]);
+	}
+};
+
+class UT_FibonacciParity : public Test::Testable {
+	const FibonacciNumbers& mNumbers;
+
+public:
+	UT_FibonacciParity(FibonacciNumbers& numbers) : Testable("Fibonacci Parity"), mNumbers(numbers) {
+		uses(numbers);
+	}
+
+protected:
+	void run() override {
+		//every third fibonacci number is even
+		for (size_t i = 0; i < mNumbers->size(); i++)
+			EXPECT_EQ(mNumbers.get()[i] % 2 == 0, i % 3 == 0);
+	}
+};
@@ -0,0 +1,22 @@
+#pragma once
+#include "../src/UnitTest.h"
+#include "fibonacci.h"
+
+struct FibonacciRow {
+	int64_t mNumber;
+	int64_t mValue;
+};
+
+class UT_FibonacciTable : public Test::ParameterizedTestable<FibonacciRow> {
+protected:
+	void runCase(const FibonacciRow& row) override {
+		EXPECT_EQ(fibonacci(row.mNumber), row.mValue);
+	}
+};
+
+class UT_FibonacciSequence : public Test::ParameterizedTestable<int64_t> {
+protected:
+	void runCase(const int64_t& number) override {
+		EXPECT_EQ(fibonacci(number), fibonacci(number - 1) + fibonacci(number - 2));
+	}
+};
@@ -0,0 +1,14 @@
+#pragma once
+#include "../src/UnitTest.h"
+#include "factorial.h"
+#include "fibonacci.h"
+
+PROPERTY(UT_FactorialProperty, "Factorial Property", Test::Generators::integer<int32_t>(1, 12)) {
+	auto [number] = values;
+	return factorial(number) == number * factorial(number - 1);
+}
+
+PROPERTY(UT_FibonacciProperty, "Fibonacci Property", Test::Generators::integer<int64_t>(2, 22)) {
+	auto [number] = values;
+	return fibonacci(number) == fibonacci(number - 1) + fibonacci(number - 2);
+}
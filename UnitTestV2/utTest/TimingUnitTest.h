@@ -1,13 +1,10 @@
 #pragma once
 #include "../src/UnitTest.h"
 
-class UT_Timing : public Test::Testable {
-public:
-	UT_Timing() : Testable("Timing Test") {};
-
-protected:
-	void run() override {
-		for (uint64_t i = 0; i < 10000000000; i++)
-			continue;
+TIMED_TEST_CASE(UT_Timing, "Timing Test", "slow", 30000) {
+	for (uint64_t i = 0; i < 10000000000; i++) {
+		//checking every iteration would dominate the loop
+		if ((i & ((uint64_t(1) << 20) - 1)) == 0 && shouldStop()) return;
+		Test::doNotOptimize(i);
 	}
-};
+}